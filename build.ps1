@@ -25,11 +25,44 @@ g++ -c src/Bullet.cpp -o obj/Bullet.o -I include -I "$SFML_INCLUDE"
 g++ -c src/MagicBullet.cpp -o obj/MagicBullet.o -I include -I "$SFML_INCLUDE"
 g++ -c src/Map.cpp -o obj/Map.o -I include -I "$SFML_INCLUDE"
 g++ -c src/Camera.cpp -o obj/Camera.o -I include -I "$SFML_INCLUDE"
+g++ -c src/FrameArena.cpp -o obj/FrameArena.o -I include -I "$SFML_INCLUDE"
+g++ -c src/AllocationCounter.cpp -o obj/AllocationCounter.o -I include -I "$SFML_INCLUDE"
+g++ -c src/ChunkStreamer.cpp -o obj/ChunkStreamer.o -I include -I "$SFML_INCLUDE"
+g++ -c src/MappedFile.cpp -o obj/MappedFile.o -I include -I "$SFML_INCLUDE"
+g++ -c src/DungeonGenerator.cpp -o obj/DungeonGenerator.o -I include -I "$SFML_INCLUDE"
+g++ -c src/SpatialGrid.cpp -o obj/SpatialGrid.o -I include -I "$SFML_INCLUDE"
+g++ -c src/DormantEnemyStore.cpp -o obj/DormantEnemyStore.o -I include -I "$SFML_INCLUDE"
+g++ -c src/EnemyFlocking.cpp -o obj/EnemyFlocking.o -I include -I "$SFML_INCLUDE"
+g++ -c src/SimClock.cpp -o obj/SimClock.o -I include -I "$SFML_INCLUDE"
+g++ -c src/TimerWheel.cpp -o obj/TimerWheel.o -I include -I "$SFML_INCLUDE"
+g++ -c src/EnemyArchetype.cpp -o obj/EnemyArchetype.o -I include -I "$SFML_INCLUDE"
+g++ -c src/CombatEvents.cpp -o obj/CombatEvents.o -I include -I "$SFML_INCLUDE"
+g++ -c src/HitRegistry.cpp -o obj/HitRegistry.o -I include -I "$SFML_INCLUDE"
+g++ -c src/ParticleSystem.cpp -o obj/ParticleSystem.o -I include -I "$SFML_INCLUDE"
+g++ -c src/Minimap.cpp -o obj/Minimap.o -I include -I "$SFML_INCLUDE"
+g++ -c src/RenderLayer.cpp -o obj/RenderLayer.o -I include -I "$SFML_INCLUDE"
+g++ -c src/PerfOverlay.cpp -o obj/PerfOverlay.o -I include -I "$SFML_INCLUDE"
+g++ -c src/SceneStack.cpp -o obj/SceneStack.o -I include -I "$SFML_INCLUDE"
+g++ -c src/GameScenes.cpp -o obj/GameScenes.o -I include -I "$SFML_INCLUDE"
+g++ -c src/AssetLoader.cpp -o obj/AssetLoader.o -I include -I "$SFML_INCLUDE"
+g++ -c src/AssetPack.cpp -o obj/AssetPack.o -I include -I "$SFML_INCLUDE"
+g++ -c src/SpriteAtlas.cpp -o obj/SpriteAtlas.o -I include -I "$SFML_INCLUDE"
+g++ -c src/MemoryBudget.cpp -o obj/MemoryBudget.o -I include -I "$SFML_INCLUDE"
+g++ -c src/SoundBank.cpp -o obj/SoundBank.o -I include -I "$SFML_INCLUDE"
+g++ -c src/AssetPaths.cpp -o obj/AssetPaths.o -I include -I "$SFML_INCLUDE"
 
 Write-Host "Linking..."
 
 # Link all object files with SFML libraries
-g++ obj/Main.o obj/Game.o obj/BaseObject.o obj/Character.o obj/SwordHero.o obj/GunHero.o obj/MagicHero.o obj/Enemy.o obj/Weapon.o obj/Sword.o obj/Bullet.o obj/MagicBullet.o obj/Map.o obj/Camera.o -o game.exe -L "$SFML_LIB" -lsfml-graphics -lsfml-window -lsfml-system -lsfml-audio
+g++ obj/Main.o obj/Game.o obj/BaseObject.o obj/Character.o obj/SwordHero.o obj/GunHero.o obj/MagicHero.o obj/Enemy.o obj/Weapon.o obj/Sword.o obj/Bullet.o obj/MagicBullet.o obj/Map.o obj/Camera.o obj/FrameArena.o obj/AllocationCounter.o obj/ChunkStreamer.o obj/MappedFile.o obj/DungeonGenerator.o obj/SpatialGrid.o obj/DormantEnemyStore.o obj/EnemyFlocking.o obj/SimClock.o obj/TimerWheel.o obj/EnemyArchetype.o obj/CombatEvents.o obj/HitRegistry.o obj/ParticleSystem.o obj/Minimap.o obj/RenderLayer.o obj/PerfOverlay.o obj/SceneStack.o obj/GameScenes.o obj/AssetLoader.o obj/AssetPack.o obj/SpriteAtlas.o obj/MemoryBudget.o obj/SoundBank.o obj/AssetPaths.o -o game.exe -L "$SFML_LIB" -lsfml-graphics -lsfml-window -lsfml-system -lsfml-audio
+
+# Sprite atlas: sheets prescaled to their on-screen size, packed with the tiles
+g++ tools/AtlasBuilder.cpp -o atlas_builder.exe -I include -I "$SFML_INCLUDE" -L "$SFML_LIB" -lsfml-graphics -lsfml-system
+.\atlas_builder.exe assets
+
+# Asset packer, then the asset pack the game loads at startup (images pre-decoded)
+g++ tools/AssetPacker.cpp src/AssetPack.cpp src/MappedFile.cpp -o asset_packer.exe -I include -I "$SFML_INCLUDE" -L "$SFML_LIB" -lsfml-graphics -lsfml-system
+.\asset_packer.exe assets.pak --rgba assets/atlas.png assets/atlas.txt assets/Enemy_spritesheet.png assets/Gun_player_spritesheet.png assets/background_menu.png assets/floor.png assets/wall.png assets/arial.TTF assets/enemies.txt assets/background_music.mp3 assets/sfx/enemy_death.wav assets/sfx/hit.wav assets/sfx/magic_hit.wav assets/sfx/player_hurt.wav assets/sfx/sword_hit.wav
 
 if (Test-Path "game.exe") {
     Write-Host "Build successful! Game executable created: game.exe"
@@ -0,0 +1,27 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <cstddef>
+
+// Counts global operator new calls in debug builds (compiled out with NDEBUG).
+// Gameplay wraps each simulation tick in beginTick()/endTick(); once warmed up,
+// a tick that allocates fails an assert. Spawning, waking and despawning work
+// in reserved storage, so no tick has a reason to touch the heap.
+class AllocationCounter {
+private:
+    static std::size_t tickStartCount;
+    static int warmupTicks;
+
+public:
+    static const int DEFAULT_WARMUP_TICKS = 60;
+
+    static bool isEnabled();
+    static std::size_t getCount(); // global operator new calls so far on the calling thread
+
+    // Steady-state tick checking
+    static void resetSteadyState(int warmup = DEFAULT_WARMUP_TICKS);
+    static void beginTick();
+    static void endTick();
+};
+
+#endif
@@ -2,13 +2,16 @@
 #define ANIMATION_H
 
 #include <SFML/Graphics.hpp>
-#include <vector>
-#include <string>
+#include <array>
+#include <cstddef>
 #include "AnimationConfig.h"
 
 class Animation {
 private:
-    std::vector<sf::IntRect> frames;
+    const FrameRect* frames;  // into a frame table from AnimationConfig.h
+    int frameCount;
+    sf::Vector2i origin;      // top-left of the sheet's grid in the texture
+    sf::Vector2i cellSize;    // frame size in the texture (smaller than the table's in the atlas)
     sf::Texture* texture;
     int currentFrame;
     float frameTime;
@@ -16,13 +19,20 @@ private:
     bool isLooping;
     bool isFinished;
 
+    void bindFrames(const FrameRect* table, int tableSize, int firstFrame, int count, const sf::IntRect& area,
+                    int cellWidth, int cellHeight);
+
 public:
     Animation();
-    Animation(sf::Texture* tex, int frameWidth, int frameHeight, int frameCount, float frameDuration = 0.1f, bool loop = true);
-    ~Animation();
     
     void setTexture(sf::Texture* tex);
-    void createFrames(int frameWidth, int frameHeight, int frameCount, int startX = 0, int startY = 0);
+    // Frames [firstFrame, firstFrame + count) of a table from AnimationConfig.h, laid out in
+    // 'area' (the sheet, or its block in the atlas) with cells of cellWidth x cellHeight
+    template <std::size_t N>
+    void setFrames(const std::array<FrameRect, N>& table, int firstFrame, int count, const sf::IntRect& area,
+                   int cellWidth, int cellHeight) {
+        bindFrames(table.data(), static_cast<int>(N), firstFrame, count, area, cellWidth, cellHeight);
+    }
     void setFrameTime(float time);
     void setLooping(bool loop);
     
@@ -31,6 +41,12 @@ public:
     
     sf::IntRect getCurrentFrame() const;
     bool getIsFinished() const;
+
+    // Stateless lookups, for many sprites sharing one frame table: each keeps only
+    // its own elapsed time (wrapped with wrapTime() so it stays small)
+    int getFrameIndexAt(float elapsed) const;
+    sf::IntRect getFrameAt(float elapsed) const;
+    float wrapTime(float elapsed) const;
     int getCurrentFrameIndex() const;
     int getFrameCount() const;
     
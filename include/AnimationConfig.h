@@ -1,36 +1,89 @@
 #ifndef ANIMATION_CONFIG_H
 #define ANIMATION_CONFIG_H
 
+#include <array>
+#include <cstddef>
+
 // ============================================================================
 // ANIMATION SYSTEM CONFIGURATION
 // ============================================================================
 // Các thông số này có thể được tùy chỉnh để phù hợp với game
 
+// Layout of one spritesheet: equal frames in rows, numbered row-major
+struct SpriteSheetConfig {
+    const char* path;
+    int width, height;           // sheet size in pixels
+    int frameWidth, frameHeight;
+    int frameCount;
+    float scaleX, scaleY;        // on-screen size / source size
+    float frameDuration;         // seconds per frame
+
+    constexpr int columns() const { return width / frameWidth; }
+    constexpr int rows() const { return height / frameHeight; }
+};
+
 // Player Animation Settings
-#define PLAYER_ANIMATION_SCALE_X 0.20f        // Scale X cho player texture (0.20 = 20% kích thước gốc) - tăng để dễ nhìn hơn
-#define PLAYER_ANIMATION_SCALE_Y 0.20f        // Scale Y cho player texture (0.20 = 20% kích thước gốc) - tăng để dễ nhìn hơn
-#define PLAYER_FRAME_WIDTH 322                // Kích thước frame gốc từ spritesheet
-#define PLAYER_FRAME_HEIGHT 217               // Kích thước frame gốc từ spritesheet
-#define PLAYER_FRAME_COUNT 20                 // Số frame trong spritesheet (đã sửa từ 17 thành 20)
-#define PLAYER_FRAME_DURATION 0.1f            // Thời gian mỗi frame (giây)
+inline constexpr SpriteSheetConfig PLAYER_SHEET = {
+    "assets/Gun_player_spritesheet.png",    // Dùng chung cho cả 3 hero
+    6440, 217,                              // Kích thước spritesheet
+    322, 217,                               // Kích thước frame gốc từ spritesheet
+    20,                                     // Số frame trong spritesheet (đã sửa từ 17 thành 20)
+    0.20f, 0.20f,                           // Scale (0.20 = 20% kích thước gốc) - tăng để dễ nhìn hơn
+    0.1f                                    // Thời gian mỗi frame (giây)
+};
 
 // Enemy Animation Settings
-#define ENEMY_ANIMATION_SCALE_X 0.12f         // Scale X cho enemy texture (0.12 = 12% kích thước gốc) - giảm để tránh crash
-#define ENEMY_ANIMATION_SCALE_Y 0.12f         // Scale Y cho enemy texture (0.12 = 12% kích thước gốc) - giảm để tránh crash
-#define ENEMY_FRAME_WIDTH 190                 // Kích thước frame gốc từ spritesheet
-#define ENEMY_FRAME_HEIGHT 175                // Kích thước frame gốc từ spritesheet
-#define ENEMY_FRAME_COUNT 70                  // Số frame trong spritesheet
-#define ENEMY_FRAME_DURATION 0.1f             // Thời gian mỗi frame (giây) - tăng để ổn định hơn
+inline constexpr SpriteSheetConfig ENEMY_SHEET = {
+    "assets/Enemy_spritesheet.png",
+    13300, 175,                             // Kích thước spritesheet
+    190, 175,                               // Kích thước frame gốc từ spritesheet
+    70,                                     // Số frame trong spritesheet
+    0.12f, 0.12f,                           // Scale (0.12 = 12% kích thước gốc) - giảm để tránh crash
+    0.1f                                    // Thời gian mỗi frame (giây) - tăng để ổn định hơn
+};
+
+// One frame: its rect in the sheet and its cell in the sheet's grid. The atlas
+// keeps the grid with smaller cells, so one table serves the sheet and the atlas.
+struct FrameRect {
+    int left, top, width, height;
+    int column, row;
+};
+
+template <std::size_t N>
+constexpr std::array<FrameRect, N> makeFrameTable(const SpriteSheetConfig& sheet) {
+    std::array<FrameRect, N> table{};
+    for (std::size_t i = 0; i < N; i++) {
+        int column = static_cast<int>(i) % sheet.columns();
+        int row = static_cast<int>(i) / sheet.columns();
+        table[i] = {column * sheet.frameWidth, row * sheet.frameHeight, sheet.frameWidth, sheet.frameHeight, column, row};
+    }
+    return table;
+}
+
+template <std::size_t N>
+constexpr bool framesFitSheet(const std::array<FrameRect, N>& table, const SpriteSheetConfig& sheet) {
+    for (const FrameRect& frame : table) {
+        if (frame.left + frame.width > sheet.width || frame.top + frame.height > sheet.height) return false;
+    }
+    return N > 0;
+}
+
+// Frame tables, built by the compiler; animations index them directly
+inline constexpr auto PLAYER_FRAMES = makeFrameTable<PLAYER_SHEET.frameCount>(PLAYER_SHEET);
+inline constexpr auto ENEMY_FRAMES = makeFrameTable<ENEMY_SHEET.frameCount>(ENEMY_SHEET);
+
+static_assert(framesFitSheet(PLAYER_FRAMES, PLAYER_SHEET), "PLAYER_SHEET frames don't fit the spritesheet");
+static_assert(framesFitSheet(ENEMY_FRAMES, ENEMY_SHEET), "ENEMY_SHEET frames don't fit the spritesheet");
 
 // Animation Performance Settings
-#define ANIMATION_UPDATE_RATE 60.0f           // Số lần update animation mỗi giây (FPS)
-#define ANIMATION_ENABLE_LOOP true            // Bật/tắt loop animation mặc định
+inline constexpr float ANIMATION_UPDATE_RATE = 60.0f;     // Số lần update animation mỗi giây (FPS)
+inline constexpr bool ANIMATION_ENABLE_LOOP = true;       // Bật/tắt loop animation mặc định
 
 // Texture Quality Settings
-#define ANIMATION_SMOOTH_TEXTURE false        // Bật/tắt smooth texture (anti-aliasing) - TẮT để tránh crash
-#define ANIMATION_REPEATED_TEXTURE false      // Bật/tắt repeated texture
+inline constexpr bool ANIMATION_SMOOTH_TEXTURE = false;   // Bật/tắt smooth texture (anti-aliasing) - TẮT để tránh crash
+inline constexpr bool ANIMATION_REPEATED_TEXTURE = false; // Bật/tắt repeated texture
 
-// Debug Settings
+// Debug Settings (macros: tested with #if)
 #define ANIMATION_DEBUG_MODE true             // Bật/tắt debug mode - BẬT để debug
 #define ANIMATION_SHOW_FRAME_INFO true        // Hiển thị thông tin frame - BẬT để debug
 
@@ -0,0 +1,117 @@
+#ifndef ASSETLOADER_H
+#define ASSETLOADER_H
+
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AssetPack.h"
+#include "MemoryBudget.h"
+
+// Loads textures and sound buffers without stalling the frame. Files are read and
+// decoded on a background thread; decoded images become textures on the main
+// thread in update() (the GL context lives there), a few per frame.
+// Requests return a handle to poll. Assets stay at the same address for the
+// loader's lifetime, and requesting the same path again returns the same handle.
+// With an asset pack open, assets in it are read from the mapping instead of loose
+// files; pre-decoded RGBA images skip the worker and go straight to the upload.
+// Under a MemoryBudget ceiling, assets nobody has retain()ed are evicted least
+// recently used first; an evicted asset reads as pending and reloads on its next get.
+class AssetLoader {
+public:
+    typedef int Handle; // 0 = no asset
+    enum class Status { PENDING, READY, FAILED, EVICTED };
+
+    static constexpr int UPLOADS_PER_UPDATE = 2; // texture uploads per frame
+
+private:
+    enum class Kind { TEXTURE, SOUND };
+
+    struct Asset {
+        std::string path;
+        Kind kind;
+        Status status;       // main thread only
+        bool decoded;        // written by the worker before it hands the asset back
+        bool packed;         // blob is valid: read from the pack, not the path
+        AssetPack::Blob blob;
+        sf::Image image;     // decoded pixels, released after the upload
+        sf::Texture texture;
+        sf::SoundBuffer sound;
+        MemoryCharge charge;
+        int references;        // retain() count; only unreferenced assets are evicted
+        unsigned int lastUsed; // useClock of the last get
+    };
+
+    AssetPack pack;                             // read-only once open; shared with the worker
+    std::vector<std::unique_ptr<Asset>> assets; // handle - 1; main thread only
+    std::deque<Asset*> uploads;                 // decoded textures waiting for update()
+    int pendingCount;
+    unsigned int useClock; // advanced by update(), once per frame
+    bool budgetWarningShown;
+
+    // Worker hand-off (guarded by mutex)
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::deque<Asset*> requests;
+    std::vector<Asset*> completed;
+    std::vector<Asset*> integrating; // main-thread copy of completed
+    bool stopping;
+
+    void workerLoop();
+    Handle request(const std::string& path, Kind kind);
+    void queue(Asset& asset);
+    bool upload(Asset& asset);
+    void finish(Asset& asset, bool ok);
+    void makeRoom(std::size_t bytes);
+    bool evictLeastRecentlyUsed();
+    Asset* find(Handle handle) const;
+    Asset* use(Handle handle, Kind kind); // stamps lastUsed, reloads if evicted
+
+public:
+    AssetLoader();
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // Before any request: assets found in the pack are served from it
+    bool openPack(const std::string& path);
+    bool hasPack() const { return pack.isOpen(); }
+
+    // Paths are relative to the asset root (AssetPaths), e.g. "assets/wall.png"
+    Handle requestTexture(const std::string& path);
+    Handle loadTextureNow(const std::string& path); // blocks; for what the first frame needs
+    Handle requestSound(const std::string& path);
+
+    // Main thread, once per frame: uploads decoded textures and publishes finished loads
+    void update();
+
+    Status getStatus(Handle handle) const;
+    bool isDone(Handle handle) const { return getStatus(handle) != Status::PENDING; }
+
+    // nullptr while pending; a file that failed to load gives an empty asset
+    sf::Texture* getTexture(Handle handle);
+    const sf::SoundBuffer* getSound(Handle handle);
+
+    // Whoever keeps a pointer from getTexture()/getSound() across frames retains the handle
+    void retain(Handle handle);
+    void release(Handle handle);
+
+    // In the pack or as a loose file; for optional assets that shouldn't warn when absent
+    bool exists(const std::string& path) const;
+
+    // Raw bytes of a packed file (e.g. a font), valid for the loader's lifetime
+    bool getFileData(const std::string& path, const unsigned char*& data, std::size_t& size) const;
+
+    // Fraction of 'handles' that are done, for loading screens
+    float getProgress(const std::vector<Handle>& handles) const;
+    int getPendingCount() const { return pendingCount; }
+};
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef ASSETPACK_H
+#define ASSETPACK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "AssetPackFile.h"
+#include "MappedFile.h"
+
+// A mapped asset pack (see AssetPackFile.h). The index is searched in place and
+// blobs are returned as pointers into the mapping: nothing is read or copied up front.
+// Read-only after open(), so lookups are safe from any thread.
+class AssetPack {
+public:
+    struct Blob {
+        const unsigned char* data;
+        std::size_t size;
+        std::uint16_t format; // AssetPackFormat
+        unsigned int width;   // RGBA8 only
+        unsigned int height;
+    };
+
+private:
+    MappedFile file;
+    const AssetPackEntry* entries;
+    std::uint32_t entryCount;
+
+public:
+    AssetPack();
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    bool open(const std::string& path);
+    bool isOpen() const { return entries != nullptr; }
+    std::uint32_t getEntryCount() const { return entryCount; }
+
+    // 'name' may be any path to the asset; it is normalized first
+    bool find(const std::string& name, Blob& blob) const;
+
+    // "../assets/Wall.png", "C:\\game\\assets\\wall.png" -> "wall.png"
+    static std::string normalizeName(const std::string& path);
+    static std::uint64_t hashName(const std::string& normalizedName); // FNV-1a
+};
+
+#endif
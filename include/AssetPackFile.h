@@ -0,0 +1,48 @@
+#ifndef ASSETPACKFILE_H
+#define ASSETPACKFILE_H
+
+#include <cstdint>
+
+// On-disk asset pack format (little-endian, version 1), built by tools/AssetPacker.cpp:
+//
+//   AssetPackHeader                    32 bytes
+//   blobs                              each starts on an ASSET_PACK_ALIGNMENT boundary
+//   AssetPackEntry[entryCount]         index, sorted by nameHash, aligned too
+//
+// Names are hashed after AssetPack::normalizeName(), so "../assets/wall.png" and
+// "assets/wall.png" are the same asset. Images may be stored pre-decoded as RGBA8
+// pixels; everything else (and images packed without --rgba) is the original file.
+
+const char ASSET_PACK_MAGIC[4] = {'S', 'K', 'P', 'K'};
+const std::uint16_t ASSET_PACK_VERSION = 1;
+const std::uint32_t ASSET_PACK_ALIGNMENT = 64; // blobs and index start on a cache line
+
+enum AssetPackFormat : std::uint16_t {
+    ASSET_PACK_FORMAT_RAW = 0,   // file bytes as they were on disk
+    ASSET_PACK_FORMAT_RGBA8 = 1  // width * height * 4 bytes of decoded pixels
+};
+
+struct AssetPackHeader {
+    char magic[4];
+    std::uint16_t version;
+    std::uint16_t flags;
+    std::uint32_t entryCount;
+    std::uint32_t reserved;
+    std::uint64_t indexOffset;       // byte offset from the start of the file
+    std::uint64_t reserved2;
+};
+
+struct AssetPackEntry {
+    std::uint64_t nameHash;          // AssetPack::hashName() of the normalized name
+    std::uint64_t offset;            // byte offset of the blob
+    std::uint64_t size;              // blob size in bytes
+    std::uint16_t format;            // AssetPackFormat
+    std::uint16_t width;             // RGBA8 only
+    std::uint16_t height;
+    std::uint16_t reserved;
+};
+
+static_assert(sizeof(AssetPackHeader) == 32, "AssetPackHeader layout is part of the file format");
+static_assert(sizeof(AssetPackEntry) == 32, "AssetPackEntry layout is part of the file format");
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef ASSETPATHS_H
+#define ASSETPATHS_H
+
+#include <string>
+
+// Every asset path in the code is relative to one root ("assets/wall.png",
+// "assets.pak"), resolved against the directory holding the executable rather
+// than whatever directory the game was started from. If that directory has no
+// assets/ folder its parent is tried (a build output folder), then the working directory.
+class AssetPaths {
+private:
+    static std::string findRoot();
+
+public:
+    static const std::string& getRoot(); // ends with a separator, or is empty (working directory)
+    static std::string resolve(const std::string& relativePath);
+};
+
+#endif
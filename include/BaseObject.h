@@ -2,10 +2,13 @@
 #define BASEOBJECT_H
 
 #include <SFML/Graphics.hpp>
+#include <memory>
 #include <string>
 #include <iostream>
 #include "Animation.h"
 #include "AnimationConfig.h"
+#include "AssetPaths.h"
+#include "MemoryBudget.h"
 
 enum class ObjectType {
     CHARACTER,
@@ -17,8 +20,14 @@ enum class ObjectType {
 // Enhanced base class for all game objects
 class BaseObject {
 protected:
+    // A texture the object loaded itself (loadTexture()); copies of the object share it
+    struct OwnTexture {
+        sf::Texture texture;
+        MemoryCharge charge;
+    };
+
     sf::Sprite sprite;
-    sf::Texture texture;
+    std::shared_ptr<OwnTexture> ownTexture;
     sf::Vector2f velocity;
     bool isAlive;
     
@@ -31,7 +40,7 @@ public:
     BaseObject(const BaseObject& other) : isAlive(other.isAlive), currentAnimation(nullptr), useAnimation(false) {
         // QUAN TRỌNG: Không copy animation - sẽ được setup lại
         sprite = other.sprite;
-        texture = other.texture;
+        ownTexture = other.ownTexture;
         velocity = other.velocity;
     }
     
@@ -51,7 +60,7 @@ public:
             // Copy các thành phần khác
             isAlive = other.isAlive;
             sprite = other.sprite;
-            texture = other.texture;
+            ownTexture = other.ownTexture;
             velocity = other.velocity;
             useAnimation = false; // Reset animation state
         }
@@ -72,8 +81,14 @@ public:
     }
 
     // Texture and sprite management
-    bool loadTexture(const std::string& file) {
-        return texture.loadFromFile(file);
+    bool loadTexture(const std::string& file) { // 'file' is relative to the asset root
+        auto loaded = std::make_shared<OwnTexture>();
+        if (!loaded->texture.loadFromFile(AssetPaths::resolve(file))) {
+            return false;
+        }
+        loaded->charge.set(loaded->texture);
+        ownTexture = loaded;
+        return true;
     }
 
     void setSprite(const sf::Texture& tex) {
@@ -3,8 +3,10 @@
 
 #include <SFML/Graphics.hpp>
 #include "BaseObject.h"
+#include "SpriteAtlas.h"
 #include "Map.h" // Include for template method
 #include "Input.h" // Include for input handling
+#include "SimClock.h"
 #include <string>
 
 class Character : public BaseObject {
@@ -22,9 +24,10 @@ protected:
     int attackDamage;
 
     // Combat system
-    sf::Clock attackCooldown;
-    sf::Clock skillCooldown;
+    Cooldown attackCooldown; // simulation ticks, frozen while paused
+    Cooldown skillCooldown;
     sf::Vector2f aimDirection; // Unified aim direction for all heroes
+    sf::RectangleShape aimLine; // Reused by drawAimIndicator every frame
 
     // Combat parameters (can be overridden by derived classes)
     int attackCooldownMs;
@@ -62,6 +65,7 @@ public:
 
     // Animation support
     void setupPlayerAnimation(const std::string& spritesheetPath, int frameWidth, int frameHeight, int frameCount);
+    void setupPlayerAnimation(const SpriteFrames* frames); // shared sheet or atlas block; nullptr = load PLAYER_SHEET.path
     
     // Template method for bullet management (defined in header for template instantiation)
     template<typename BulletType>
@@ -77,9 +81,7 @@ public:
             }
 
             // Remove bullet if it hits wall or goes out of bounds
-            if (hitWall ||
-                bulletPos.x < -100 || bulletPos.x > 3300 ||  // MAP_WIDTH * TILE_SIZE + buffer
-                bulletPos.y < -100 || bulletPos.y > 2532) {  // MAP_HEIGHT * TILE_SIZE + buffer
+            if (hitWall || (map && !map->isWithinWorld(bulletPos, 100.0f))) {
                 bullets.erase(bullets.begin() + i);
             } else {
                 ++i;
@@ -115,7 +117,7 @@ public:
     int getMaxMana() const { return maxMana; }
     bool getIsAlive() const override { return BaseObject::getIsAlive(); }
     float getSpeed() const { return speed; }
-    std::string getName() const { return name; }
+    const std::string& getName() const { return name; }
     void setName(const std::string& newName) { name = newName; }
 
     // Combat getters/setters
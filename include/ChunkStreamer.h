@@ -0,0 +1,113 @@
+#ifndef CHUNKSTREAMER_H
+#define CHUNKSTREAMER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "WorldChunk.h"
+
+// Keeps a bounded set of world chunks resident around a focus point.
+// Missing chunks are produced by a ChunkSource on a background thread and
+// handed back to the main thread in update(), which never waits for the worker.
+// Far chunks are evicted least-recently-needed first once the budget is full.
+class ChunkStreamer {
+public:
+    // Must be thread-safe and deterministic: it runs on the worker thread, and an
+    // evicted chunk is simply produced again when the camera comes back.
+    typedef std::function<void(int chunkX, int chunkY, WorldChunk& chunk)> ChunkSource;
+
+    static constexpr int DEFAULT_BUDGET = 256;     // resident chunks (~256 KB of tiles)
+    static constexpr int DEFAULT_LOAD_RADIUS = 3;  // chunks requested around the focus
+    static constexpr int STAGING_BUFFERS = 8;      // loads in flight
+
+private:
+    static constexpr std::int16_t NOT_RESIDENT = -1;
+    static constexpr std::int16_t REQUESTED = -2;
+
+    struct Slot {
+        int chunkIndex;              // -1 = free
+        unsigned int serial;         // changes on every (re)load
+        unsigned int lastNeededFrame;
+        WorldChunk chunk;
+    };
+
+    struct CompletedLoad {
+        int chunkIndex;
+        int stagingIndex;
+    };
+
+    int chunksX, chunksY;
+    int loadRadius;
+    ChunkSource source;
+
+    // Main-thread state
+    std::vector<Slot> slots;
+    std::vector<std::int16_t> directory; // chunk index -> slot, NOT_RESIDENT or REQUESTED
+    unsigned int frame;
+    unsigned int nextSerial;
+
+    // Worker hand-off (guarded by mutex)
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::vector<int> requestRing;
+    int requestHead, requestCount;
+    std::vector<WorldChunk> staging;
+    std::vector<int> freeStaging;
+    std::vector<CompletedLoad> completed;
+    std::vector<CompletedLoad> integrating; // main-thread copy of completed
+    bool stopping;
+
+    void workerLoop();
+    void requestChunk(int chunkIndex);
+    int acquireSlot();
+    void integrate(int chunkIndex, const WorldChunk& chunk);
+
+public:
+    ChunkStreamer(int chunksX, int chunksY, ChunkSource source,
+                  int residentBudget = DEFAULT_BUDGET, int loadRadius = DEFAULT_LOAD_RADIUS);
+    ~ChunkStreamer();
+
+    ChunkStreamer(const ChunkStreamer&) = delete;
+    ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+
+    // Request chunks around the focus, integrate finished loads and mark what is
+    // still needed. Returns true if the resident set changed.
+    bool update(int focusChunkX, int focusChunkY);
+
+    // Synchronously produce the chunks around a point (startup / teleports only)
+    void prefetch(int focusChunkX, int focusChunkY, int radius);
+
+    // Queries (main thread)
+    const WorldChunk* getChunk(int chunkX, int chunkY) const {
+        std::int16_t slot = directory[chunkY * chunksX + chunkX];
+        return slot >= 0 ? &slots[slot].chunk : nullptr;
+    }
+    WorldChunk* getMutableChunk(int chunkX, int chunkY) {
+        std::int16_t slot = directory[chunkY * chunksX + chunkX];
+        return slot >= 0 ? &slots[slot].chunk : nullptr;
+    }
+    unsigned int getChunkSerial(int chunkX, int chunkY) const {
+        std::int16_t slot = directory[chunkY * chunksX + chunkX];
+        return slot >= 0 ? slots[slot].serial : 0;
+    }
+
+    // Calls f(chunkX, chunkY, chunk) for every resident chunk
+    template<typename F>
+    void forEachResidentChunk(F f) const {
+        for (const auto& slot : slots) {
+            if (slot.chunkIndex >= 0) {
+                f(slot.chunkIndex % chunksX, slot.chunkIndex / chunksX, slot.chunk);
+            }
+        }
+    }
+
+    int getResidentCount() const;
+    int getBudget() const { return static_cast<int>(slots.size()); }
+    std::size_t getMemoryBytes() const;
+};
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef COMBATEVENTS_H
+#define COMBATEVENTS_H
+
+#include <SFML/System.hpp>
+#include <cstdint>
+#include <vector>
+
+enum class DamageSource : std::uint8_t {
+    BULLET,
+    MAGIC_BULLET,
+    SWORD,
+    ENEMY_CONTACT
+};
+
+// 8 bytes. target is an index into Game::enemies, or PLAYER_TARGET.
+struct DamageEvent {
+    std::uint16_t target;
+    std::int16_t amount;
+    DamageSource source;
+    std::uint8_t reserved;
+    std::uint16_t order;   // emitter-local index (bullet, enemy...), for a stable sort
+};
+
+struct KillEvent {
+    sf::Vector2f position;
+    std::uint8_t archetype;
+    DamageSource source;   // what landed the killing blow
+};
+
+// Per-tick combat queue. Collision code only appends events; resolution
+// (Game::resolveCombatEvents) sorts them into a fixed order and is the one
+// place that changes hp, score and experience. Because emitters never mutate
+// shared state, collision jobs could run in parallel and append to their own
+// queues, merged before resolution, with identical results.
+class CombatEventQueue {
+public:
+    static const std::uint16_t PLAYER_TARGET = 0xFFFF;
+    static const int DEFAULT_CAPACITY = 256;
+
+private:
+    std::vector<DamageEvent> damageEvents;
+    std::vector<KillEvent> killEvents;
+
+public:
+    explicit CombatEventQueue(int capacity = DEFAULT_CAPACITY);
+
+    void pushDamage(int target, int amount, DamageSource source, int order) {
+        damageEvents.push_back({static_cast<std::uint16_t>(target), static_cast<std::int16_t>(amount), source, 0,
+                                static_cast<std::uint16_t>(order)});
+    }
+    void pushKill(sf::Vector2f position, int archetype, DamageSource source) {
+        killEvents.push_back({position, static_cast<std::uint8_t>(archetype), source});
+    }
+    void append(const CombatEventQueue& other); // merge a job-local queue
+
+    // Orders damage by (target, source, order), independent of emission order
+    void sortDamage();
+
+    const std::vector<DamageEvent>& getDamageEvents() const { return damageEvents; }
+    const std::vector<KillEvent>& getKillEvents() const { return killEvents; }
+    void clear();
+};
+
+#endif
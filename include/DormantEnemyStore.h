@@ -0,0 +1,70 @@
+#ifndef DORMANTENEMYSTORE_H
+#define DORMANTENEMYSTORE_H
+
+#include <SFML/System.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "SpatialGrid.h"
+
+class Map; // Forward declaration
+
+// Cold tier for enemies far from the player. Instead of a full Enemy (sprite,
+// texture, animation...) each dormant enemy is a few bytes in parallel arrays,
+// moved with a cheap wander step a couple of times per second, and indexed by a
+// SpatialGrid so waking never scans the whole store.
+class DormantEnemyStore {
+public:
+    static const int DEFAULT_CAPACITY = 512;
+
+private:
+    int capacity;
+    std::vector<sf::Vector2f> positions;
+    std::vector<std::int16_t> hp;
+    std::vector<std::uint8_t> heading; // 256 steps per turn
+    std::vector<std::uint8_t> archetype; // EnemyArchetypes index
+    SpatialGrid grid;
+    std::vector<int> wakeScratch;
+    std::minstd_rand rng;
+
+    void removeAt(int index); // swap with the last entry
+
+public:
+    explicit DormantEnemyStore(int capacity = DEFAULT_CAPACITY);
+
+    void clear();
+    int size() const { return static_cast<int>(positions.size()); }
+
+    // Stores an enemy. When full, the entry farthest from 'focus' is dropped for good.
+    void add(sf::Vector2f position, int hitPoints, int archetypeIndex, sf::Vector2f focus);
+
+    // Simplified movement for all dormant enemies, then re-index them
+    void update(const Map* map, float dt, float speed);
+
+    // Removes up to maxCount dormant enemies within radius of center and calls
+    // f(position, hitPoints, archetypeIndex) for each. Returns how many woke up.
+    template<typename F>
+    int wakeWithin(sf::Vector2f center, float radius, int maxCount, F f) {
+        wakeScratch.clear();
+        grid.queryRadius(center, radius, [this, maxCount](int index) {
+            if (static_cast<int>(wakeScratch.size()) < maxCount) {
+                wakeScratch.push_back(index);
+            }
+        });
+        if (wakeScratch.empty()) return 0;
+
+        // Remove from the back so swap-removal doesn't move entries still to be woken
+        std::sort(wakeScratch.begin(), wakeScratch.end(), [](int a, int b) { return a > b; });
+        for (int index : wakeScratch) {
+            f(positions[index], static_cast<int>(hp[index]), static_cast<int>(archetype[index]));
+            removeAt(index);
+        }
+        grid.rebuild(positions.data(), size());
+        return static_cast<int>(wakeScratch.size());
+    }
+
+    std::size_t getMemoryBytes() const;
+};
+
+#endif
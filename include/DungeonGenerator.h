@@ -0,0 +1,105 @@
+#ifndef DUNGEONGENERATOR_H
+#define DUNGEONGENERATOR_H
+
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "Tile.h"
+
+struct DungeonSettings {
+    int minLeafSize = 12;       // BSP leaves are split until they are at most maxLeafSize
+    int maxLeafSize = 24;
+    int minRoomSize = 5;
+    int corridorWidth = 2;      // characters are about one tile wide
+    int spawnCount = 50;
+    int minSpawnDistance = 7;   // tiles between the start and any enemy spawn
+    int threads = 0;            // row-band workers, 0 = hardware concurrency
+};
+
+// BSP rooms joined by L-shaped corridors, with a connectivity guarantee.
+// generate() fills a row-major grid in which every passable tile is reachable
+// from the start tile: a flood fill from the start seals anything left over,
+// and enemy spawns are sampled from the reachable set only.
+// Exits open the outer wall and join the rooms, so neighbouring grids (the
+// streamed world's sectors) that open facing exits are connected too.
+// Whole-grid passes (carving, doors, sealing) run in parallel over row bands.
+// No SFML dependency, so it can run on any thread.
+class DungeonGenerator {
+public:
+    static const int MIN_SIZE = 5; // outer wall + 1 tile of wall around a 1x1 room
+
+    struct Rect {
+        int x, y, width, height;
+    };
+
+    struct TilePos {
+        int x, y;
+    };
+
+private:
+    enum Region : std::uint8_t {
+        REGION_ROOM = 1,
+        REGION_CORRIDOR = 2,
+        REGION_REACHABLE = 0x80 // set by the flood fill
+    };
+
+    struct BspNode {
+        Rect area;
+        int left, right; // child node indices, -1 for leaves
+        int room;        // leaf: its room; inner node: a room from its subtree
+    };
+
+    int width, height;
+    DungeonSettings settings;
+    std::minstd_rand rng;
+
+    std::vector<TileType> tiles;
+    std::vector<std::uint8_t> regions;
+    std::vector<BspNode> nodes;
+    std::vector<Rect> rooms;
+    std::vector<Rect> corridors;
+    std::vector<int> reachable; // tile indices in flood-fill order
+    std::vector<TilePos> spawnTiles;
+    std::vector<TilePos> exits;
+    TilePos start;
+    int doorCount;
+    int sealedCount;
+
+    int randomRange(int minValue, int maxValue); // inclusive
+    void buildBsp();
+    void connectRooms();
+    void carve();
+    void placeDoors();
+    void floodFill();
+    void sealUnreachable();
+    void sampleSpawns();
+
+    // Runs f(firstRow, endRow) on each row band in parallel
+    template<typename F>
+    void forEachRowBand(F f) const;
+
+    bool isPassableAt(int x, int y) const {
+        return x >= 0 && y >= 0 && x < width && y < height && tiles[y * width + x] != TileType::WALL;
+    }
+
+public:
+    DungeonGenerator(int width, int height, unsigned int seed, const DungeonSettings& settings);
+
+    // An opening corridorWidth tiles long in the outer wall, starting at (x, y)
+    // and running along the wall; must be added before generate()
+    void addExit(int x, int y);
+
+    // False (and an all-wall grid) if the grid is smaller than MIN_SIZE
+    bool generate();
+
+    // Results (row-major)
+    TileType getTile(int x, int y) const { return tiles[y * width + x]; }
+    const std::vector<Rect>& getRooms() const { return rooms; }
+    const std::vector<TilePos>& getSpawnTiles() const { return spawnTiles; }
+    TilePos getStart() const { return start; }
+    int getReachableCount() const { return static_cast<int>(reachable.size()); }
+    int getDoorCount() const { return doorCount; }
+    int getSealedCount() const { return sealedCount; }
+};
+
+#endif
@@ -2,48 +2,90 @@
 #define ENEMY_H
 
 #include <SFML/Graphics.hpp>
-#include "BaseObject.h"
+#include "Animation.h"
+#include "SimClock.h"
+#include "EnemyArchetype.h"
+#include "SpriteAtlas.h"
 
 class Map; // Forward declaration
 
-class Enemy : public BaseObject {
+// A plain value: stats and behaviour come from the archetype table, drawing from
+// state shared by every enemy (one sheet, one frame table per sprite clip). Copying
+// or moving an enemy around the vector never touches the heap.
+class Enemy {
 private:
-    sf::RectangleShape shape; // Keep for backward compatibility
-    float speed;
-    int hp, maxHp;
-    int damage;
-    sf::Clock attackCooldown;
+    static const int ATTACK_COOLDOWN_MS = 500;
+
+    static constexpr float CHARGE_DASH_SCALE = 2.5f;   // speed multiplier while dashing
+    static constexpr float CHARGE_REST_SCALE = 0.3f;   // ... and between dashes
+    static constexpr float AMBUSH_TRIGGER_FRACTION = 0.4f; // of detection range
+    static const int COWARD_FLEE_PERCENT = 30;         // flees below this much hp
+    static constexpr float STEER_LOOKAHEAD = 24.f;     // wall probe distance along the steering heading
+
+    // Shared by all enemies: the spritesheet (or atlas block) Game owns, a frame
+    // table per sprite clip over it, and the shapes draw() reuses
+    static SpriteFrames sheet;
+    static Animation clipAnimations[EnemyArchetypes::MAX_CLIPS];
+    static sf::Sprite sprite;
+    static sf::RectangleShape body;      // drawn instead of the sprite when there is no sheet
+    static sf::RectangleShape healthBarBack;
+    static sf::RectangleShape healthBarFill;
+
+    sf::Vector2f position;
+    std::uint32_t id;         // stable across vector moves, for per-attack hit registries
+    std::uint8_t archetype;   // index into EnemyArchetypes: speed, damage, ranges, sprite...
+    bool isAlive;
+    int hp;
+    Cooldown attackCooldown;
+    float animationTime;      // into the archetype clip's shared frame table
 
     // AI behavior
     sf::Vector2f targetPosition;
-    float detectionRange;
-    float attackRange;
+    bool alerted;             // AMBUSH: has seen the player
+
+    // Steering chosen by think(); movement follows it until the next decision
+    sf::Vector2f steerDirection;
+    sf::Vector2f avoidance;   // separation/cohesion/wall offset from EnemyFlocking
+    bool decisionStale;       // blocked since the last decision
+    unsigned char lodPhase;   // staggers reduced-rate updates across enemies
+
+    bool isDashing() const; // CHARGE: inside a dash window
+    const Animation& getClipAnimation() const { return clipAnimations[getArchetype().spriteClip]; }
 
 public:
-    Enemy(float x, float y);
-    ~Enemy(); // Destructor để cleanup animation
-    Enemy(const Enemy& other); // Copy constructor
-    Enemy& operator=(const Enemy& other); // Assignment operator
-    void update(sf::Vector2f playerPos, const Map* map);
-    void draw(sf::RenderWindow &window);
+    Enemy(float x, float y, int archetypeIndex = 0);
+    void update(sf::Vector2f playerPos, const Map* map, float dt = 1.f/60.f);
+    void think(sf::Vector2f playerPos, const Map* map); // steering decision (time-sliced by Game)
+    bool needsDecision() const { return decisionStale; }
+    unsigned char getLodPhase() const { return lodPhase; }
+    void setAvoidance(sf::Vector2f offset) { avoidance = offset; }
+    void animate(float dt);
+    void draw(sf::RenderWindow &window) const;
     void takeDamage(int damage);
 
-    // Getters (override BaseObject methods for backward compatibility)
-    sf::Vector2f getPosition() const override { return shape.getPosition(); }
-    sf::FloatRect getBounds() const override { return shape.getGlobalBounds(); }
-    bool getIsAlive() const override { return BaseObject::getIsAlive(); }
-    
-    // Override setPosition to sync sprite and shape
-    void setPosition(float x, float y) override;
-    int getDamage() const { return damage; }
+    sf::Vector2f getPosition() const { return position; }
+    sf::FloatRect getBounds() const; // the archetype's hitbox, centred on the position
+    bool getIsAlive() const { return isAlive; }
+    void setPosition(float x, float y) { position = sf::Vector2f(x, y); }
+    int getDamage() const { return getArchetype().damage; }
+    const EnemyArchetype& getArchetype() const { return EnemyArchetypes::get(archetype); }
+    int getArchetypeIndex() const { return archetype; }
+    std::uint32_t getId() const { return id; }
+    float getHitRadius() const { return getArchetype().hitRadius; }
+    int getHp() const { return hp; }
+    void setHp(int hitPoints) { hp = hitPoints; }
     bool canAttack() const;
 
     // Combat
     bool isInAttackRange(sf::Vector2f playerPos) const;
     void attackPlayer();
-    
-    // Animation support
-    void setupEnemyAnimation(const std::string& spritesheetPath, int frameWidth, int frameHeight, int frameCount);
+
+    // Animation support: binds every clip to the shared sheet (Game owns it and keeps
+    // it alive while enemies exist); without one, enemies are drawn as plain shapes
+    static void setSpritesheet(const SpriteFrames& sharedFrames);
+    static bool hasSpritesheet() { return sheet.texture != nullptr; }
+    int getAnimationFrame() const { return getClipAnimation().getFrameIndexAt(animationTime); }
+    int getAnimationFrameCount() const { return getClipAnimation().getFrameCount(); }
 };
 
 #endif
@@ -0,0 +1,84 @@
+#ifndef ENEMYARCHETYPE_H
+#define ENEMYARCHETYPE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+
+// AI behaviours, dispatched with a switch in Enemy::update (no virtual calls)
+enum class EnemyBehaviour : std::uint8_t {
+    CHASE,   // straight at the player once in detection range
+    CHARGE,  // slow approach broken by short, fast dashes
+    AMBUSH,  // waits until the player is close, then chases for good
+    COWARD   // chases, but runs away when badly hurt
+};
+
+// A rectangle of frames in the enemy spritesheet
+struct SpriteClip {
+    std::int16_t x, y;
+    std::int16_t frameWidth, frameHeight;
+    std::uint8_t frameCount;
+};
+
+// Immutable stats shared by every enemy of one type. Enemies keep only an
+// index into the table plus their own mutable state (position, hp, ...).
+struct EnemyArchetype {
+    float speed;              // pixels per second
+    float detectionRange;
+    float attackRange;
+    std::int16_t maxHp;
+    std::int16_t damage;
+    std::uint8_t hitboxWidth, hitboxHeight;
+    float hitRadius;          // circle around the hitbox, for melee/AoE shapes
+    std::uint8_t spriteClip;
+    EnemyBehaviour behaviour;
+    std::uint32_t tint;       // RGBA multiplied into the sprite, tells the types apart
+    std::uint8_t spawnWeight; // relative chance of being picked by pickRandom()
+    char name[15];
+};
+
+// Table of enemy types, loaded once from a small text file:
+//   clip  <id> <x> <y> <frameWidth> <frameHeight> <frameCount>
+//   enemy <name> <behaviour> <hp> <damage> <speed> <detect> <attack> <hitW> <hitH> <clip> <tint RRGGBBAA> <weight>
+// '#' starts a comment. If the file is missing or broken the built-in
+// default (the original single enemy type) is used, so index 0 always exists.
+class EnemyArchetypes {
+public:
+    static const int MAX_ARCHETYPES = 32;
+    static const int MAX_CLIPS = 16;
+
+private:
+    static EnemyArchetype archetypes[MAX_ARCHETYPES];
+    static SpriteClip clips[MAX_CLIPS];
+    static int archetypeCount;
+    static int clipCount;
+    static int totalSpawnWeight;
+    static float maxHitRadius;
+
+    static void loadDefaults();
+    static bool parseBehaviour(const std::string& text, EnemyBehaviour& behaviour);
+    static bool parseTint(const std::string& text, std::uint32_t& tint); // RRGGBBAA hex
+    static bool parse(std::istream& input, const std::string& source);
+
+public:
+    static bool load(const std::string& path);
+    static bool loadFromMemory(const unsigned char* data, std::size_t size); // e.g. from the asset pack
+
+    static int count() { return archetypeCount; }
+    static const EnemyArchetype& get(int index) {
+        return archetypes[(index >= 0 && index < archetypeCount) ? index : 0];
+    }
+    static const SpriteClip& getClip(int index) {
+        return clips[(index >= 0 && index < clipCount) ? index : 0];
+    }
+    static int find(const std::string& name); // -1 if unknown
+
+    // Largest hitRadius of any type: how far beyond an attack shape to look for enemies
+    static float getMaxHitRadius() { return maxHitRadius; }
+
+    // Weighted pick; 'roll' is any non-negative random number
+    static int pickRandom(unsigned int roll);
+};
+
+#endif
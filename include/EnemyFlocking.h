@@ -0,0 +1,52 @@
+#ifndef ENEMYFLOCKING_H
+#define ENEMYFLOCKING_H
+
+#include <SFML/System.hpp>
+#include <vector>
+#include "SpatialGrid.h"
+
+class Map; // Forward declaration
+
+struct FlockingSettings {
+    float neighbourRadius = 40.f;   // a bit more than one enemy (28px) apart
+    float separationWeight = 1.2f;
+    float cohesionWeight = 0.15f;   // keeps hordes loosely together, never overrides separation
+    float obstacleWeight = 0.8f;
+    float obstacleProbe = 18.f;     // distance of the wall probes around each enemy
+};
+
+// Local avoidance for the active enemies. Neighbours come from a SpatialGrid
+// query capped at the K nearest, written into fixed-size slots (unused slots
+// point at the enemy itself and contribute nothing). The steering itself is
+// then one branch-free pass over flat x/y arrays with a fixed trip count,
+// which the compiler can vectorise. Cost is O(n * K), never O(n^2).
+class EnemyFlocking {
+public:
+    static const int MAX_NEIGHBOURS = 6;
+
+private:
+    FlockingSettings settings;
+    SpatialGrid grid;
+
+    // Structure of arrays, rebuilt by compute()
+    std::vector<float> posX, posY;
+    std::vector<int> neighbours;     // count * MAX_NEIGHBOURS
+    std::vector<float> steerX, steerY;
+
+    void gatherNeighbours(const sf::Vector2f* positions, int count);
+    void accumulateSteering(int count);
+    void addObstacleRepulsion(int count, const Map* map);
+
+public:
+    explicit EnemyFlocking(const FlockingSettings& settings = FlockingSettings());
+
+    void reserve(int maxEnemies);
+
+    // Computes a steering offset for each position (roughly unit scale)
+    void compute(const sf::Vector2f* positions, int count, const Map* map);
+
+    sf::Vector2f getSteering(int index) const { return sf::Vector2f(steerX[index], steerY[index]); }
+    std::size_t getMemoryBytes() const;
+};
+
+#endif
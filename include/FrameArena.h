@@ -0,0 +1,57 @@
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// std::pmr adapter so standard containers can allocate from the frame arena:
+//   std::pmr::vector<sf::Vector2f> points(FrameArena::getResource());
+class FrameArenaResource : public std::pmr::memory_resource {
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+// Linear (bump) allocator for transient per-frame data.
+// Everything allocated from it is released at once by reset() at the top of
+// every frame, so scratch lists and formatted UI strings cost a pointer bump
+// instead of a heap allocation. Memory must never be kept across frames.
+class FrameArena {
+private:
+    static std::vector<unsigned char> buffer;
+    static std::size_t offset;
+    static std::size_t highWaterMark;
+    static std::size_t overflowBytes;   // bytes that did not fit this frame
+    static std::size_t requestedGrowth; // capacity wanted after an overflow
+    static std::vector<char*> overflowStrings; // format() results that spilled to the heap
+    static FrameArenaResource resource;
+
+public:
+    static const std::size_t DEFAULT_CAPACITY = 256 * 1024;
+
+    // Initialization
+    static void initialize(std::size_t capacityBytes = DEFAULT_CAPACITY);
+
+    // Release everything allocated during the previous frame (call once per frame)
+    static void reset();
+
+    // Raw allocation - falls back to the heap if the arena is exhausted
+    static void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t));
+    static void deallocate(void* p, std::size_t bytes, std::size_t alignment);
+    static bool owns(const void* p);
+
+    // Standard container support
+    static std::pmr::memory_resource* getResource() { return &resource; }
+
+    // printf-style formatting into arena memory (valid until the next reset)
+    static const char* format(const char* fmt, ...);
+
+    // Statistics
+    static std::size_t getUsedBytes() { return offset; }
+    static std::size_t getCapacity() { return buffer.size(); }
+    static std::size_t getHighWaterMark() { return highWaterMark; }
+};
+
+#endif
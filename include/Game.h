@@ -10,19 +10,126 @@
 #include "GunHero.h"
 #include "MagicHero.h"
 #include "Enemy.h"
+#include "DormantEnemyStore.h"
+#include "SpatialGrid.h"
+#include "EnemyFlocking.h"
+#include "CombatEvents.h"
+#include "HitRegistry.h"
+#include "ParticleSystem.h"
+#include "Minimap.h"
+#include "SceneStack.h"
+#include "AssetLoader.h"
+#include "SoundBank.h"
+#include "PerfOverlay.h"
 #include "GameState.h"
 #include "Map.h"
+#include "SimClock.h"
 #include "Camera.h"
 #include "Input.h"
 #include "View.h"
 
-class Game {
+class Game : public TimerListener {
 private:
+    // World size in tiles - streamed in 32x32 chunks around the player
+    static constexpr int WORLD_WIDTH_TILES = 2048;
+    static constexpr int WORLD_HEIGHT_TILES = 2048;
+    // A shipped level in the binary map format replaces the streamed world if present
+    static constexpr const char* LEVEL_FILE_PATH = "assets/level.map";
+    static constexpr const char* ENEMY_TYPES_PATH = "assets/enemies.txt";
+    static constexpr const char* ENEMY_SPRITESHEET_PATH = "assets/Enemy_spritesheet.png";
+    static constexpr const char* MENU_BACKGROUND_PATH = "assets/background_menu.png";
+    static constexpr const char* FONT_PATH = "assets/arial.TTF";
+    static constexpr const char* MUSIC_PATH = "assets/background_music.mp3";
+    // Built by the atlas builder (make atlas): every game sprite and tile in one
+    // prescaled texture; without it the loose sheets are used
+    static constexpr const char* ATLAS_TEXTURE_PATH = "assets/atlas.png";
+    static constexpr const char* ATLAS_TABLE_PATH = "assets/atlas.txt";
+    // Built by the asset packer (make pack); assets missing from it load from loose files
+    static constexpr const char* ASSET_PACK_PATH = "assets.pak";
+    // Texture/sound memory ceiling in MB for low-memory machines (unset = no limit)
+    static constexpr const char* MEMORY_BUDGET_VARIABLE = "SOUL_KNIGHT_MEMORY_MB";
+
+    // Enemy simulation tiers: far enemies sleep in the dormant store and wake
+    // when the player comes back (wake radius < sleep radius to avoid flapping)
+    static constexpr float ENEMY_SLEEP_RADIUS = 1000.0f;
+    static constexpr float ENEMY_WAKE_RADIUS = 800.0f;
+    static const int ENEMY_TIER_UPDATE_TICKS = 30; // dormant tier runs at 2 Hz
+    static const int MAX_ACTIVE_ENEMIES = 24;
+    static const int ENEMY_SPAWN_INTERVAL_MS = 3000;
+    static const int KILL_SCORE = 100;
+    static const int KILL_EXP = 25;
+    enum TimerEvent { EVENT_SPAWN_ENEMY };
+
+    // Enemy AI level of detail: near enemies move every tick, farther ones every
+    // 2nd/4th tick with a scaled step. Steering decisions are time-sliced
+    // round-robin under a per-tick budget, so AI cost stays flat with enemy count.
+    static constexpr float AI_NEAR_RADIUS = 400.0f;
+    static constexpr float AI_MID_RADIUS = 700.0f;
+    static const int AI_MID_INTERVAL = 2;
+    static const int AI_FAR_INTERVAL = 4;
+    static const int AI_DECISION_BUDGET_MICROSECONDS = 300;
+    static const int AI_BUDGET_CHECK_DECISIONS = 8; // decisions between clock reads
+
+    // Frame pacing. The loop paces itself instead of using setFramerateLimit so it
+    // can choose where the wait goes: early sampling waits after rendering (as the
+    // limiter did), late sampling waits first and samples input just before the
+    // tick, so input->present is about one frame's work instead of up to two frames.
+    static const int TARGET_FRAME_MICROSECONDS = 16667; // 60 FPS
+    static const int LATE_INPUT_MARGIN_MICROSECONDS = 2000; // slack for sleep overshoot
+
+    // Idle mode: static menus block until the next event; a minimised window
+    // wakes every MINIMISED_SLEEP_MS to drain events and see if it was restored
+    // (restoring doesn't send an event everywhere). An unfocused window pauses
+    // the game and is paced at 10 FPS.
+    static const int UNFOCUSED_FRAME_MICROSECONDS = 100000;
+    static const int MINIMISED_SLEEP_MS = 250;
+
     sf::RenderWindow window;
-    GameState state;
+
+    // Screens: one Scene per GameState (see GameScenes.cpp); only the stack's top one runs
+    class MainMenuScene;
+    class PausedMenuScene;
+    class NameInputScene;
+    class CharacterSelectScene;
+    class LeaderboardScene;
+    class SettingsScene;
+    class GameplayScene;
+    class LoadingScene;
+    std::vector<std::unique_ptr<Scene>> scenes; // indexed by GameState
+    SceneStack sceneStack;
+
+    // Textures used in game, decoded in the background from startup on; the loading
+    // screen waits for them. Declared before everything that points into it.
+    // Each screen retains only what it draws, so a memory budget can evict the rest:
+    // the game textures from loading to the end of a game, the menu background in the menus.
+    AssetLoader assets;
+    std::vector<AssetLoader::Handle> gameAssets; // what the loading screen waits for
+    bool gameTexturesHeld;
+    AssetLoader::Handle menuBackgroundAsset;
+    bool menuBackgroundHeld;
+    AssetLoader::Handle playerSpritesheetAsset;
+    AssetLoader::Handle enemySpritesheetAsset;
+    AssetLoader::Handle wallTextureAsset;
+    AssetLoader::Handle floorTextureAsset;
+    AssetLoader::Handle atlasAsset; // replaces the four above when the atlas table loaded
+    int selectedHero; // 1-3, created once loading is done
+    SoundBank sounds; // combat effects; buffers owned by assets
 
     std::unique_ptr<Character> player;
     std::vector<Enemy> enemies;
+    DormantEnemyStore dormantEnemies;
+    SpatialGrid activeEnemyGrid;
+    std::vector<sf::Vector2f> activeEnemyPositions; // scratch for activeEnemyGrid
+    std::vector<std::uint8_t> activeEnemyKeep;      // scratch for demotion
+    EnemyFlocking enemyFlocking;                    // separation between active enemies
+    CombatEventQueue combatEvents;                  // damage/kills of the current tick
+    HitRegistry meleeHits;                          // enemies already hit by the current swing
+    ParticleSystem particles;                       // hit, death and muzzle effects
+    Minimap minimap;                                // HUD, top-right corner
+    SpriteFrames enemyFrames;                       // shared by every Enemy, texture owned by assets
+    unsigned int enemyTierTick;
+    unsigned int aiTick;
+    size_t aiDecisionCursor; // next enemy to think() when the budget allows
     std::unique_ptr<Map> gameMap;
 
     // Camera system
@@ -41,25 +148,44 @@ private:
     // Game stats
     int score;
     int enemiesKilled;
-    sf::Clock gameTimer;
-    sf::Clock enemySpawnTimer;
+    std::uint32_t gameStartTick;          // SimClock tick, so pauses don't count as play time
+    TimerWheel::Handle enemySpawnTimer;
+    bool enemySpawnDue;                   // set by the spawn timer, cleared when an enemy spawns
 
     // UI elements now handled by View system
 
-    // Audio system
+    // Audio system: the music streams, so it never holds a decoded buffer
     sf::Music backgroundMusic;
     bool musicEnabled;
     float musicVolume;
     std::vector<std::string> settingsOptions;
     int settingsSelectedOption;
 
+    // Frame pacing and latency measurement
+    sf::Clock frameClock;              // never restarted: time base for pacing and input timestamps
+    sf::Time lastPresentTime;
+    sf::Int64 frameWorkMicroseconds;   // input sample -> present, smoothed
+    bool lateInputSampling;
+    bool windowFocused;
+    PerfOverlay perfOverlay;
+
+    void createScenes();
+    Scene* getScene(GameState id) { return scenes[static_cast<int>(id)].get(); }
+
     void processEvents();
+    void handleWindowEvent(const sf::Event& event);
+    void waitForFrameSlot(sf::Time deadline); // keeps draining events while it waits
+    void waitWhileIdle();                     // returns when there is something to draw
+    bool isIdle() const;
+    bool isMinimised() const;
+    void handleDebugInput(); // F3 overlay, F4 input sampling mode
     void handleGameInput(); // Handle game-specific input using Input system
-    void handleMenuInput(); // Handle menu navigation using Input system
+    void handleMainMenuInput(); // Handle menu navigation using Input system
+    void handlePausedMenuInput();
+    void handleNameInputEvent(const sf::Event& event); // text entry is event-based
     void handleCharacterSelection(); // Handle character selection using Input system
     void handleSettings(); // Handle settings input using Input system
     void handleLeaderboard(); // Handle leaderboard input using Input system
-    void update();
     void render();
 
     // menu handlers
@@ -69,6 +195,15 @@ private:
     void renderCharacterSelect();
     void renderLeaderboard();
     void renderSettings();
+    void renderLoading();
+    void requestGameAssets();
+    void holdGameTextures();    // loading screen: retains (and reloads if evicted) gameAssets
+    void releaseGameTextures(); // back in the menus after a game
+    sf::Texture* getLooseTexture(AssetLoader::Handle& handle, const char* path); // what the atlas lacks
+    void holdMenuBackground();
+    void releaseMenuBackground();
+    void updateMenuBackground(); // shows the background again once an evicted copy has reloaded
+    void finishLoading(); // creates the selected hero and starts the game
     void startGame();
     void continueGame();
 
@@ -79,8 +214,12 @@ private:
 
     // game logic
     void updateGameplay();
-    void checkCollisions();
+    void checkCollisions();      // emits combat events only
+    void resolveCombatEvents();  // applies them: hp, kills, score, exp
     void spawnEnemies();
+    Enemy& spawnEnemy(float x, float y, int archetype = -1); // -1 = weighted random type
+    void updateEnemyTiers();
+    void updateEnemies();
     void renderGameplay();
     void renderUI();
 
@@ -96,6 +235,8 @@ private:
 
 public:
     Game();
+    ~Game();
+    void onTimer(int eventId) override;
     void run();
 };
 
@@ -9,6 +9,7 @@ enum class GameState {
     IN_GAME,
     LEADERBOARD,
     SETTINGS,
+    LOADING,
     EXIT
 };
 
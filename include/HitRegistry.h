@@ -0,0 +1,36 @@
+#ifndef HITREGISTRY_H
+#define HITREGISTRY_H
+
+#include <cstdint>
+#include <vector>
+
+// Which targets one attack (a sword swing, a slash...) has already hit, so a
+// shape that stays active for many ticks damages each target once.
+// Open-addressing hash set of target ids. Starting a new attack is O(1): slots
+// are stamped with the attack they belong to, so nothing has to be cleared.
+class HitRegistry {
+public:
+    static const int DEFAULT_CAPACITY = 1024; // rounded up to a power of two
+
+private:
+    std::vector<std::uint32_t> ids;
+    std::vector<std::uint32_t> stamps; // slot is used when stamps[slot] == currentStamp
+    std::uint32_t mask;
+    std::uint32_t currentStamp;
+    std::uint32_t currentAttack;
+    int count;
+
+public:
+    explicit HitRegistry(int capacity = DEFAULT_CAPACITY);
+
+    // Switch to attackId; a different id than last time forgets all hits
+    void begin(std::uint32_t attackId);
+
+    // True the first time targetId is registered during the current attack.
+    // When the table is full every further hit is refused.
+    bool registerHit(std::uint32_t targetId);
+
+    int size() const { return count; }
+};
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef HITSHAPE_H
+#define HITSHAPE_H
+
+#include <SFML/System.hpp>
+#include <algorithm>
+#include <cmath>
+
+// Exact attack shapes for melee and AoE hits, tested against circular hitboxes.
+//   SECTOR:  a pie slice (sword swing arc) - apex, bisector, radius, half angle
+//   CAPSULE: a thick line segment (special slash) - start, axis, length, radius
+struct HitShape {
+    enum Kind { SECTOR, CAPSULE };
+
+    Kind kind;
+    sf::Vector2f origin;     // sector apex / capsule start
+    sf::Vector2f direction;  // unit bisector / unit axis
+    float length;            // sector radius / capsule segment length
+    float radius;            // capsule radius (0 for sectors)
+    float cosHalfAngle;      // sector only
+    sf::Vector2f edgeA, edgeB; // sector only: unit directions of the two straight edges
+
+    static HitShape sector(sf::Vector2f apex, float centerAngleRadians, float halfAngleRadians, float sectorRadius) {
+        HitShape shape;
+        shape.kind = SECTOR;
+        shape.origin = apex;
+        shape.direction = sf::Vector2f(std::cos(centerAngleRadians), std::sin(centerAngleRadians));
+        shape.length = sectorRadius;
+        shape.radius = 0.f;
+        shape.cosHalfAngle = std::cos(halfAngleRadians);
+        shape.edgeA = sf::Vector2f(std::cos(centerAngleRadians - halfAngleRadians), std::sin(centerAngleRadians - halfAngleRadians));
+        shape.edgeB = sf::Vector2f(std::cos(centerAngleRadians + halfAngleRadians), std::sin(centerAngleRadians + halfAngleRadians));
+        return shape;
+    }
+
+    static HitShape capsule(sf::Vector2f start, sf::Vector2f unitAxis, float segmentLength, float capsuleRadius) {
+        HitShape shape;
+        shape.kind = CAPSULE;
+        shape.origin = start;
+        shape.direction = unitAxis;
+        shape.length = segmentLength;
+        shape.radius = capsuleRadius;
+        shape.cosHalfAngle = 1.f;
+        shape.edgeA = shape.edgeB = unitAxis;
+        return shape;
+    }
+
+    // Circle enclosing the shape, for spatial index queries
+    sf::Vector2f getBoundsCenter() const {
+        return kind == CAPSULE ? origin + direction * (length * 0.5f) : origin;
+    }
+    float getBoundsRadius() const {
+        return kind == CAPSULE ? length * 0.5f + radius : length;
+    }
+
+    bool intersectsCircle(sf::Vector2f center, float circleRadius) const {
+        if (kind == CAPSULE) {
+            return distanceSqToSegment(center, origin, direction, length) <= (radius + circleRadius) * (radius + circleRadius);
+        }
+
+        sf::Vector2f offset = center - origin;
+        float distSq = offset.x * offset.x + offset.y * offset.y;
+        float reach = length + circleRadius;
+        if (distSq > reach * reach) return false;
+        if (distSq <= circleRadius * circleRadius) return true; // apex inside the circle
+
+        // Centre within the angular range: the distance test above is exact
+        float dist = std::sqrt(distSq);
+        if (offset.x * direction.x + offset.y * direction.y >= cosHalfAngle * dist) return true;
+
+        // Otherwise the circle can only touch one of the straight edges
+        float rSq = circleRadius * circleRadius;
+        return distanceSqToSegment(center, origin, edgeA, length) <= rSq ||
+               distanceSqToSegment(center, origin, edgeB, length) <= rSq;
+    }
+
+    static float distanceSqToSegment(sf::Vector2f point, sf::Vector2f start, sf::Vector2f unitAxis, float segmentLength) {
+        sf::Vector2f offset = point - start;
+        float t = std::max(0.f, std::min(segmentLength, offset.x * unitAxis.x + offset.y * unitAxis.y));
+        sf::Vector2f closest = start + unitAxis * t;
+        float dx = point.x - closest.x;
+        float dy = point.y - closest.y;
+        return dx * dx + dy * dy;
+    }
+};
+
+#endif
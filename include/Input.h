@@ -3,6 +3,7 @@
 
 #include <SFML/Graphics.hpp>
 #include <SFML/Window.hpp>
+#include <cstdint>
 
 class Camera; // Forward declaration
 
@@ -25,22 +26,41 @@ struct InputConfig {
     sf::Mouse::Button secondaryAttack = sf::Mouse::Right;
 };
 
+// Key and mouse state is kept from the window's event stream (handleEvent)
+// in packed bitsets; nothing is polled from the OS. update() snapshots the
+// state once per frame, and "just pressed/released" is the XOR of this and
+// the previous snapshot. A key pressed and released between two updates
+// still reads as pressed for one frame.
 class Input {
 private:
+    static const int KEY_WORDS = (sf::Keyboard::KeyCount + 63) / 64;
+
     static sf::RenderWindow* window;
     static Camera* camera;
     static InputConfig config;
 
-    // Mouse state
+    // Mouse state (one bit per sf::Mouse::Button)
     static sf::Vector2i lastMousePosition;
-    static bool leftMousePressed;
-    static bool rightMousePressed;
-    static bool previousLeftMousePressed;
-    static bool previousRightMousePressed;
-
-    // Keyboard state
-    static bool keyStates[sf::Keyboard::KeyCount];
-    static bool previousKeyStates[sf::Keyboard::KeyCount];
+    static std::uint32_t mouseDown;          // live, from events
+    static std::uint32_t mousePressedLatch;  // presses since the last update()
+    static std::uint32_t mouseStates;        // this frame's snapshot
+    static std::uint32_t previousMouseStates;
+
+    // Keyboard state (one bit per sf::Keyboard::Key)
+    static std::uint64_t keysDown[KEY_WORDS];
+    static std::uint64_t keysPressedLatch[KEY_WORDS];
+    static std::uint64_t keyStates[KEY_WORDS];
+    static std::uint64_t previousKeyStates[KEY_WORDS];
+
+    // Latency measurement: arrival time of the oldest input event not yet sampled
+    static sf::Time pendingInputTime;
+    static bool hasPendingInput;
+    static sf::Time sampledInputTime; // ... and the one the last update() consumed
+    static bool hasSampledInput;
+
+    static bool testBit(const std::uint64_t* words, sf::Keyboard::Key key) {
+        return key >= 0 && key < sf::Keyboard::KeyCount && ((words[key >> 6] >> (key & 63)) & 1u);
+    }
 
 public:
     // Initialization
@@ -51,8 +71,13 @@ public:
     static void setConfig(const InputConfig& newConfig);
     static InputConfig getConfig();
     
-    // Update input state (call once per frame)
+    // Feed every window event through here, then call update() once per frame.
+    // 'timestamp' is when the event was drained, on the caller's clock.
+    static void handleEvent(const sf::Event& event, sf::Time timestamp = sf::Time::Zero);
     static void update();
+
+    // Arrival time of the oldest input event consumed by the last update(), if any
+    static bool getSampledInputTime(sf::Time& timestamp);
     
     // Keyboard input
     static bool isKeyPressed(sf::Keyboard::Key key);
@@ -107,8 +132,12 @@ public:
     static bool isSettingsVolumeDownPressed();
     static bool isSettingsMusicTogglePressed();
 
+    // Debug / performance
+    static bool isPerfOverlayTogglePressed();   // F3
+    static bool isInputSamplingTogglePressed(); // F4
+
     // Text input helpers
-    static bool handleTextInput(sf::Event& event, std::string& text, int maxLength = 20);
+    static bool handleTextInput(const sf::Event& event, std::string& text, int maxLength = 20);
 
     // Utility functions
     static sf::Vector2f normalizeVector(sf::Vector2f vector);
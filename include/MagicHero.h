@@ -13,7 +13,7 @@ private:
     std::vector<MagicBullet> magicBullets;
 
 public:
-    MagicHero();
+    explicit MagicHero(const SpriteFrames* frames = nullptr); // shared preloaded frames, or load our own sheet
     void update(const Map* map) override;
     void attack() override { performAttack(); }
     void skill() override { performSkill(); }
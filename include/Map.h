@@ -2,63 +2,194 @@
 #define MAP_H
 
 #include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
-
-enum class TileType {
-    EMPTY = 0,
-    WALL = 1,
-    DOOR = 2,
-    SPAWN_POINT = 3
-};
-
-struct Tile {
-    TileType type;
-    sf::RectangleShape shape;
-    bool isPassable;
-    
-    Tile() : type(TileType::EMPTY), isPassable(true) {
-        shape.setSize(sf::Vector2f(32.f, 32.f));
-    }
-};
+#include "Tile.h"
+#include "WorldChunk.h"
+#include "ChunkStreamer.h"
+#include "DungeonGenerator.h"
+#include "MappedFile.h"
+#include "MemoryBudget.h"
 
 class Map {
+public:
+    // RESIDENT: whole grid allocated up front and generated by DungeonGenerator.
+    // STREAMED: only chunks near the focus point are resident; the rest are
+    // generated on a background thread as the camera approaches. The world is
+    // split into sectors of SECTOR_CHUNKS x SECTOR_CHUNKS chunks, each its own
+    // DungeonGenerator dungeon with gates facing its neighbours' gates, so every
+    // floor tile in the world is reachable from the player's start.
+    // Maps opened with loadFromFile() are resident, with tiles read from the mapped file.
+    enum class Storage {
+        RESIDENT,
+        STREAMED
+    };
+
 private:
-    static const int MAP_WIDTH = 100;  // 25 * 4
-    static const int MAP_HEIGHT = 76;  // 19 * 4
+    static const int DEFAULT_WIDTH = 100;  // 25 * 4
+    static const int DEFAULT_HEIGHT = 76;  // 19 * 4
     static const int TILE_SIZE = 32;
+    static const std::uint32_t MAX_FILE_DIMENSION = 32768; // keeps tileIndex() within int
+
+    // Render chunks: one vertex array per texture per WorldChunk
+    static const int RENDER_CHUNK_CACHE_SIZE = 16;
+
+    // Streamed world sectors (256x256 tiles), generated whole and cut into chunks
+    static const int SECTOR_CHUNKS = 8;
+    static const int SECTOR_TILES = SECTOR_CHUNKS * WorldChunk::SIZE;
+    static const int SECTOR_CACHE_SIZE = 4; // the focus area touches at most 4 sectors
+    static const int GATE_MARGIN = 8;       // tiles between a gate and a sector corner
+
+    struct Sector {
+        int sectorX, sectorY;   // -1 = slot is free
+        unsigned int lastUsed;
+        int originX, originY, width, height; // in world tiles
+        std::vector<TileType> tiles;         // row-major
+        std::vector<DungeonGenerator::TilePos> spawnTiles; // world tiles, reachable
+        DungeonGenerator::TilePos start;     // world tile
+        bool valid;                          // false if the sector was too small to generate
+
+        Sector() : sectorX(-1), sectorY(-1), lastUsed(0), originX(0), originY(0), width(0), height(0),
+                   start{0, 0}, valid(false) {}
+    };
+
+    struct RenderChunk {
+        int chunkX, chunkY;
+        unsigned int lastUsedFrame; // 0 = slot is free
+        unsigned int sourceSerial;  // streamer serial the vertices were built from
+        sf::VertexArray floorVertices;
+        sf::VertexArray wallVertices;
+
+        RenderChunk() : chunkX(-1), chunkY(-1), lastUsedFrame(0), sourceSerial(0),
+                        floorVertices(sf::Quads), wallVertices(sf::Quads) {}
+    };
+
+    int width, height;     // in tiles
+    int chunksX, chunksY;  // in WorldChunks
+    unsigned int seed;
+
+    std::vector<Tile> tiles; // RESIDENT only: chunk-major, see tileIndex()
+    Tile* tileData;          // RESIDENT only: tiles.data() or the mapped file's tile layer
+    std::unique_ptr<MappedFile> mappedFile;
+
+    // STREAMED only. Used by the streaming thread and by prefetch/saving on the
+    // main thread; declared before the streamer, whose worker uses them until joined.
+    int sectorsX, sectorsY;
+    mutable std::vector<Sector> sectorCache;
+    mutable unsigned int sectorUseCounter;
+    mutable std::mutex sectorMutex;
+    std::unique_ptr<ChunkStreamer> streamer; // STREAMED only
+
+    sf::Texture ownWallTexture;  // loadTextures() only
+    sf::Texture ownFloorTexture;
+    MemoryCharge ownTextureCharge;   // both own textures
+    const sf::Texture* wallTexture;  // the own textures, or shared ones from setTextures()
+    const sf::Texture* floorTexture;
+    sf::FloatRect wallTextureRect;   // area of the texture drawn on a tile (atlas entry or all of it)
+    sf::FloatRect floorTextureRect;
+
+    std::vector<RenderChunk> renderChunks;
+    unsigned int renderFrame;
+    unsigned int tileRevision; // bumped whenever any tile may have changed
 
-    std::vector<std::vector<Tile>> tiles;
-    sf::Texture wallTexture;
-    sf::Texture floorTexture;
-    
     std::vector<sf::Vector2f> enemySpawnPoints;
     sf::Vector2f playerSpawnPoint;
-    
-    void initializeRoom();
-    void createWalls();
-    void createDoors();
-    void setSpawnPoints();
+
+    void allocateResident(int widthInTiles, int heightInTiles); // all WALL, nothing generated
+    void generateDungeon();
+    void detachMappedFile(); // copies the tiles out of the mapping and closes it
     sf::Vector2f findSafeSpawnPoint(sf::Vector2f preferredPoint, float searchRadius);
 
+    // Streaming helpers
+    void generateChunk(int chunkX, int chunkY, WorldChunk& chunk) const; // runs on the streaming thread
+    const Sector& getSector(int sectorX, int sectorY) const; // sectorMutex must be held
+    void generateSector(Sector& sector, int sectorX, int sectorY) const;
+    int getGateOffset(int sectorX, int sectorY, bool eastBorder, int borderLength) const;
+    void rebuildStreamedSpawnPoints();
+    void readChunk(int chunkX, int chunkY, WorldChunk& chunk) const; // tiles and streamed spawns
+
+    // Rendering helpers
+    RenderChunk& getRenderChunk(int chunkX, int chunkY);
+    void buildRenderChunk(RenderChunk& chunk, int chunkX, int chunkY);
+    void invalidateRenderChunk(int tileX, int tileY);
+    void invalidateAllRenderChunks();
+    void drawTileRange(sf::RenderWindow& window, int startX, int startY, int endX, int endY);
+
+    unsigned int getChunkSerial(int chunkX, int chunkY) const {
+        return streamer ? streamer->getChunkSerial(chunkX, chunkY) : 0;
+    }
+
+    int tileIndex(int x, int y) const {
+        int chunk = (y >> WorldChunk::SHIFT) * chunksX + (x >> WorldChunk::SHIFT);
+        return chunk * WorldChunk::TILE_COUNT + WorldChunk::tileIndex(x & WorldChunk::MASK, y & WorldChunk::MASK);
+    }
+
 public:
     Map();
-    void loadTextures();
+    Map(int widthInTiles, int heightInTiles, Storage storage);
+    explicit Map(const std::string& path); // falls back to a generated map if the file can't be loaded
+
+    // Binary map files (see MapFile.h). Loading maps the file; tiles are not parsed or copied.
+    // Saving may copy a mapped map's tiles into memory first (Windows can't replace a mapped file).
+    // Saving is an offline/tool path, never called during play: for a streamed map it
+    // generates every chunk of the world synchronously on the calling thread.
+    bool loadFromFile(const std::string& path);
+    bool saveToFile(const std::string& path);
+
+    static constexpr const char* WALL_TEXTURE_PATH = "assets/wall.png";
+    static constexpr const char* FLOOR_TEXTURE_PATH = "assets/floor.png";
+    void loadTextures(); // synchronous; the game passes preloaded textures to setTextures() instead
+    // Must outlive the map. Empty rects mean the whole texture; with the sprite
+    // atlas both textures are the atlas and the rects are the tiles' entries.
+    void setTextures(const sf::Texture* wall, const sf::Texture* floor,
+                     const sf::IntRect& wallRect = sf::IntRect(), const sf::IntRect& floorRect = sf::IntRect());
     void draw(sf::RenderWindow& window);
     void drawInView(sf::RenderWindow& window, sf::Vector2f cameraCenter, sf::Vector2f viewSize);
     bool isPassable(float x, float y) const;
     bool isPassable(sf::Vector2f position) const;
-    
+
+    // Streams chunks around the focus point. Never blocks; call once per tick.
+    void updateStreaming(sf::Vector2f focus);
+    bool isStreamed() const { return streamer != nullptr; }
+    unsigned int getTileRevision() const { return tileRevision; } // for caches built from the tiles
+
+    // Tile access (out-of-bounds and not-yet-loaded tiles read as walls)
+    bool isInBounds(int tileX, int tileY) const {
+        return tileX >= 0 && tileX < width && tileY >= 0 && tileY < height;
+    }
+    Tile getTile(int tileX, int tileY) const {
+        if (!isInBounds(tileX, tileY)) return Tile(TileType::WALL);
+        if (streamer) {
+            const WorldChunk* chunk = streamer->getChunk(tileX >> WorldChunk::SHIFT, tileY >> WorldChunk::SHIFT);
+            return chunk ? chunk->getTile(tileX & WorldChunk::MASK, tileY & WorldChunk::MASK) : Tile(TileType::WALL);
+        }
+        return tileData[tileIndex(tileX, tileY)];
+    }
+    bool isPassableTile(int tileX, int tileY) const { return getTile(tileX, tileY).isPassable(); }
+    void setTile(int tileX, int tileY, TileType type); // streamed edits last until the chunk is evicted
+    int countBlockedNeighbours(int tileX, int tileY) const; // 8-neighbourhood
+
+    // True if a world position is inside the map, allowing 'buffer' pixels outside it
+    bool isWithinWorld(sf::Vector2f position, float buffer = 0.f) const {
+        return position.x >= -buffer && position.x <= width * TILE_SIZE + buffer &&
+               position.y >= -buffer && position.y <= height * TILE_SIZE + buffer;
+    }
+
     // Getters
     sf::Vector2f getPlayerSpawnPoint() const { return playerSpawnPoint; }
     const std::vector<sf::Vector2f>& getEnemySpawnPoints() const { return enemySpawnPoints; }
-    
+    std::size_t getTileMemoryBytes() const;
+
     // Utility functions
     sf::Vector2i worldToTile(sf::Vector2f worldPos) const;
     sf::Vector2f tileToWorld(sf::Vector2i tilePos) const;
-    
+
     static int getTileSize() { return TILE_SIZE; }
-    static int getMapWidth() { return MAP_WIDTH; }
-    static int getMapHeight() { return MAP_HEIGHT; }
+    int getMapWidth() const { return width; }
+    int getMapHeight() const { return height; }
 };
 
 #endif
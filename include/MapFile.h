@@ -0,0 +1,55 @@
+#ifndef MAPFILE_H
+#define MAPFILE_H
+
+#include <cstdint>
+
+// On-disk map format (little-endian, version 1):
+//
+//   MapFileHeader                      64 bytes
+//   MapFileChunkEntry[chunksX*chunksY] chunk index, row-major by chunk
+//   (padding to MAP_FILE_TILE_ALIGNMENT)
+//   tile layer                         1 byte per Tile, chunk-major, WorldChunk::TILE_COUNT per chunk
+//   MapFileSpawn[spawnCount]           spawn table, grouped by chunk
+//
+// The tile layer uses the same chunk-major order as Map's in-memory storage,
+// so a file whose layout flag matches the build is used in place through mmap.
+
+const char MAP_FILE_MAGIC[4] = {'S', 'K', 'M', 'P'};
+const std::uint16_t MAP_FILE_VERSION = 1;
+const std::uint16_t MAP_FILE_FLAG_TILED_LAYOUT = 0x0001; // tiles inside a chunk use WorldChunk tiled order
+const std::uint32_t MAP_FILE_TILE_ALIGNMENT = 4096;      // tile layer starts on a page boundary
+
+struct MapFileHeader {
+    char magic[4];
+    std::uint16_t version;
+    std::uint16_t flags;
+    std::uint32_t width;             // in tiles
+    std::uint32_t height;
+    std::uint32_t chunkSize;         // must equal WorldChunk::SIZE
+    std::uint32_t chunksX;
+    std::uint32_t chunksY;
+    std::uint32_t spawnCount;
+    float playerSpawnX;              // world position
+    float playerSpawnY;
+    std::uint64_t chunkIndexOffset;  // byte offsets from the start of the file
+    std::uint64_t tileLayerOffset;
+    std::uint64_t spawnTableOffset;
+};
+
+struct MapFileChunkEntry {
+    std::uint64_t tileOffset;        // byte offset of this chunk's WorldChunk::TILE_COUNT tiles
+    std::uint32_t firstSpawn;        // index into the spawn table
+    std::uint16_t spawnCount;
+    std::uint16_t reserved;
+};
+
+struct MapFileSpawn {
+    std::uint32_t tileX;
+    std::uint32_t tileY;
+};
+
+static_assert(sizeof(MapFileHeader) == 64, "MapFileHeader layout is part of the file format");
+static_assert(sizeof(MapFileChunkEntry) == 16, "MapFileChunkEntry layout is part of the file format");
+static_assert(sizeof(MapFileSpawn) == 8, "MapFileSpawn layout is part of the file format");
+
+#endif
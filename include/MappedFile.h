@@ -0,0 +1,45 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read-only file mapped into memory (mmap / MapViewOfFile).
+// Pages are private copy-on-write: writing through getMutableData() changes
+// this process's view only and is never written back to the file.
+class MappedFile {
+private:
+    unsigned char* data;
+    std::size_t size;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return data != nullptr; }
+    const unsigned char* getData() const { return data; }
+    unsigned char* getMutableData() { return data; }
+    std::size_t getSize() const { return size; }
+
+    // True if [offset, offset + length) lies inside the file; safe for untrusted offsets
+    bool contains(std::uint64_t offset, std::uint64_t length) const {
+        return offset <= size && length <= size - offset;
+    }
+
+    // Renames 'source' over 'target', replacing it. On Windows the target must
+    // not be mapped by anyone (close() it first).
+    static bool replaceFile(const std::string& source, const std::string& target);
+};
+
+#endif
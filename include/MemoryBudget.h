@@ -0,0 +1,76 @@
+#ifndef MEMORYBUDGET_H
+#define MEMORYBUDGET_H
+
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+#include <cstddef>
+#include <ostream>
+
+enum class MemoryCategory {
+    TEXTURE,        // GPU
+    RENDER_TEXTURE, // GPU, off-screen targets
+    SOUND,          // host, decoded samples
+    COUNT
+};
+
+// Memory held by textures, render textures and sound buffers, measured against
+// an optional ceiling. Sizes are estimated from dimensions: 4 bytes per texel
+// (no mipmaps are generated) and 2 bytes per sample. Main thread only.
+// Owners keep a MemoryCharge next to each resource and set it whenever the
+// resource is (re)created; AssetLoader evicts its least recently used
+// unreferenced assets while the total is over the budget.
+class MemoryBudget {
+private:
+    static const int CATEGORY_COUNT = static_cast<int>(MemoryCategory::COUNT);
+
+    static std::size_t usage[CATEGORY_COUNT];
+    static std::size_t peak[CATEGORY_COUNT];
+    static std::size_t peakTotal;
+    static std::size_t budget; // 0 = unlimited
+    static unsigned int evictionCount;
+
+    friend class MemoryCharge;
+    static void add(MemoryCategory category, std::size_t bytes);
+    static void remove(MemoryCategory category, std::size_t bytes);
+
+public:
+    static void setBudget(std::size_t bytes) { budget = bytes; }
+    static std::size_t getBudget() { return budget; }
+
+    static std::size_t getUsage(MemoryCategory category) { return usage[static_cast<int>(category)]; }
+    static std::size_t getTotal();
+    static std::size_t getPeakTotal() { return peakTotal; }
+
+    // Would 'extraBytes' more go over the budget?
+    static bool exceeds(std::size_t extraBytes = 0);
+
+    static void recordEviction() { evictionCount++; }
+    static unsigned int getEvictionCount() { return evictionCount; }
+
+    static std::size_t bytesOf(const sf::Texture& texture);
+    static std::size_t bytesOf(const sf::SoundBuffer& sound);
+
+    static void report(std::ostream& out); // per category, current and peak
+};
+
+// The bytes one resource holds. Copying a charge charges again, as copying the
+// resource it sits next to allocates again.
+class MemoryCharge {
+private:
+    MemoryCategory category;
+    std::size_t bytes;
+
+public:
+    explicit MemoryCharge(MemoryCategory chargeCategory = MemoryCategory::TEXTURE);
+    MemoryCharge(const MemoryCharge& other);
+    MemoryCharge& operator=(const MemoryCharge& other);
+    ~MemoryCharge();
+
+    void set(std::size_t newBytes);
+    void set(const sf::Texture& texture) { set(MemoryBudget::bytesOf(texture)); }
+    void set(const sf::SoundBuffer& sound) { set(MemoryBudget::bytesOf(sound)); }
+    void release() { set(static_cast<std::size_t>(0)); }
+    std::size_t getBytes() const { return bytes; }
+};
+
+#endif
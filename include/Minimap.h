@@ -0,0 +1,53 @@
+#ifndef MINIMAP_H
+#define MINIMAP_H
+
+#include <SFML/Graphics.hpp>
+#include "MemoryBudget.h"
+
+class Map;
+
+// HUD minimap. The tiles around the player are rendered once into an
+// off-screen texture at one pixel per tile, and only re-rendered when the
+// map's tiles change or the player walks out of the cached window. A frame
+// then costs one sprite plus one vertex array holding every marker.
+class Minimap {
+private:
+    static const int CACHE_TILES = 128;       // side of the cached tile window
+    static const int VIEW_TILES = 64;         // side of the area shown on screen
+    static const int MIN_REBUILD_FRAMES = 10; // tile edits are batched over this many frames
+    static const int MAX_MARKERS = 1024;
+
+    sf::FloatRect screenRect;
+
+    sf::RenderTexture tileTexture;
+    MemoryCharge tileTextureCharge;
+    sf::VertexArray tilePixels; // one point per cached tile; only the colours change
+    sf::Sprite tileSprite;
+    bool textureReady;          // false until created, or if the texture can't be created
+
+    const Map* cachedMap;
+    unsigned int cachedRevision;
+    int originX, originY;       // tile at the cached window's top-left corner
+    int viewX, viewY;           // tile at the shown area's top-left corner
+    int framesSinceRebuild;
+    int rebuildCount;
+
+    sf::VertexArray markers;    // sf::Triangles, two per marker
+
+    void rebuild(const Map& map);
+
+public:
+    Minimap(float screenX, float screenY, float screenSize = 150.f);
+
+    // Once per frame, before the markers are added
+    void update(const Map& map, sf::Vector2f playerPosition);
+
+    void clearMarkers() { markers.clear(); }
+    void addMarker(sf::Vector2f worldPosition, sf::Color color, float size = 3.f); // size in screen pixels
+    void draw(sf::RenderTarget& target);
+
+    const sf::FloatRect& getScreenRect() const { return screenRect; }
+    int getRebuildCount() const { return rebuildCount; }
+};
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef PARTICLESYSTEM_H
+#define PARTICLESYSTEM_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+enum class ParticleBlend : std::uint8_t {
+    ALPHA,
+    ADDITIVE,
+    COUNT
+};
+
+// Description of one burst of particles
+struct ParticleBurst {
+    int count;
+    float speedMin, speedMax;   // pixels per second
+    float spread;               // radians around the emit direction (6.28 = all round)
+    float lifetime;             // seconds, +-25% per particle
+    float size;                 // pixels, shrinks to 0 over the lifetime
+    float damping;              // fraction of velocity kept per second
+    sf::Color color;
+    ParticleBlend blend;
+};
+
+// Fixed-capacity particle pool in structure-of-arrays layout. Emission,
+// update and drawing never allocate after construction: dead particles are
+// compacted away each update, and drawing writes every visible particle into
+// one sf::VertexArray per blend mode (two triangles each), so the whole
+// system costs at most one draw call per blend mode.
+class ParticleSystem {
+public:
+    static const int DEFAULT_CAPACITY = 32768;
+
+    // Presets used by the game
+    static const ParticleBurst HIT_SPARK;
+    static const ParticleBurst DEATH_BURST;
+    static const ParticleBurst PLAYER_HIT;
+    static const ParticleBurst MUZZLE_FLASH;
+    static const ParticleBurst MAGIC_SPARK;
+    static const ParticleBurst SWORD_SWISH;
+
+private:
+    int capacity;
+    int count;
+
+    std::vector<float> posX, posY;
+    std::vector<float> velX, velY;
+    std::vector<float> age, lifetime;
+    std::vector<float> particleSize, drag;
+    std::vector<sf::Color> color;
+    std::vector<ParticleBlend> blend;
+
+    sf::VertexArray vertices[static_cast<int>(ParticleBlend::COUNT)];
+    std::minstd_rand rng;
+
+    float randomRange(float minValue, float maxValue);
+
+public:
+    explicit ParticleSystem(int capacity = DEFAULT_CAPACITY);
+
+    // Emits burst.count particles at position, fanned around direction.
+    // Particles that don't fit in the pool are dropped.
+    void emit(sf::Vector2f position, sf::Vector2f direction, const ParticleBurst& burst);
+    void emit(sf::Vector2f position, sf::Vector2f direction, const ParticleBurst& burst, sf::Color tint);
+
+    void update(float dt);
+
+    // Draws the particles inside viewBounds (one draw call per blend mode in use)
+    void draw(sf::RenderTarget& target, const sf::FloatRect& viewBounds);
+
+    void clear() { count = 0; }
+    int size() const { return count; }
+    int getCapacity() const { return capacity; }
+};
+
+#endif
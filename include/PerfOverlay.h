@@ -0,0 +1,42 @@
+#ifndef PERFOVERLAY_H
+#define PERFOVERLAY_H
+
+#include <SFML/System.hpp>
+#include <cstdint>
+
+// Frame timing, input-to-present latency and MemoryBudget usage, drawn over the game with F3.
+// Latency is measured from the oldest input event a frame consumed (timestamped
+// when it was drained from the window) to the return of that frame's display();
+// scan-out and the compositor add to it on top.
+class PerfOverlay {
+public:
+    static const int LATENCY_BUCKET_MS = 1;
+    static const int LATENCY_BUCKETS = 50; // the last bucket also counts everything slower
+
+private:
+    bool visible;
+    std::uint32_t latencyCounts[LATENCY_BUCKETS];
+    std::uint32_t latencySamples;
+    sf::Int64 latencyTotalMicroseconds;
+    float frameMilliseconds; // smoothed
+    float workMilliseconds;  // input sample -> present, smoothed
+
+public:
+    PerfOverlay();
+
+    void toggle() { visible = !visible; }
+    bool isVisible() const { return visible; }
+
+    void recordFrame(sf::Time frameTime, sf::Time workTime);
+    void recordLatency(sf::Time latency);
+    void resetLatency();
+
+    // Upper edge of the bucket containing the given fraction of samples (0..1)
+    float getLatencyPercentile(float fraction) const;
+    float getAverageLatency() const;
+    std::uint32_t getLatencySampleCount() const { return latencySamples; }
+
+    void draw(float x, float y, bool lateInputSampling) const; // through View
+};
+
+#endif
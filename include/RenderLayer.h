@@ -0,0 +1,50 @@
+#ifndef RENDERLAYER_H
+#define RENDERLAYER_H
+
+#include <SFML/Graphics.hpp>
+#include "MemoryBudget.h"
+
+// A screen (or part of one) drawn once into an off-screen texture and then
+// shown as a single textured quad. The contents are only redrawn after
+// markDirty(); View's UI functions draw into the layer while it is redrawn.
+// If the texture can't be created the contents are drawn directly every frame.
+class RenderLayer {
+private:
+    sf::RenderTexture texture;
+    MemoryCharge textureCharge;
+    sf::Sprite sprite;
+    sf::Color clearColor;
+    bool created;
+    bool dirty;
+    int redrawCount;
+
+    void beginRedraw();
+    void endRedraw();
+
+public:
+    RenderLayer();
+
+    bool create(unsigned int width, unsigned int height, sf::Color clearColor = sf::Color::Black);
+
+    void markDirty() { dirty = true; }
+    bool isDirty() const { return dirty; }
+    int getRedrawCount() const { return redrawCount; }
+
+    // drawContents() is only called when the layer is dirty
+    template<typename F>
+    void draw(sf::RenderTarget& target, F drawContents) {
+        if (!created) {
+            drawContents();
+            return;
+        }
+        if (dirty) {
+            beginRedraw();
+            drawContents();
+            endRedraw();
+        }
+        target.setView(target.getDefaultView());
+        target.draw(sprite);
+    }
+};
+
+#endif
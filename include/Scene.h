@@ -0,0 +1,33 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <SFML/Window.hpp>
+#include "GameState.h"
+
+// One screen of the game (menu, pause, gameplay...). Only the top scene of the
+// SceneStack receives events, update() and render(); scenes below it do nothing.
+class Scene {
+private:
+    GameState id;
+
+public:
+    explicit Scene(GameState id) : id(id) {}
+    virtual ~Scene() {}
+
+    GameState getId() const { return id; }
+
+    virtual void onEnter() {} // pushed onto the stack
+    virtual void onExit() {}  // removed from the stack
+    virtual void handleEvent(const sf::Event&) {} // raw window events, e.g. text input
+    virtual void update() = 0; // input and simulation, once per frame
+    virtual void render() = 0;
+
+    // Drawn over a frozen image of the scene below, captured when this scene covered it
+    virtual bool showsSceneBelow() const { return false; }
+    // Redrawn only after input or a scene change (a cached RenderLayer in between)
+    virtual bool isStatic() const { return false; }
+    // False when nothing moves on its own: the loop may sleep until the next event
+    virtual bool isAnimating() const { return !isStatic(); }
+};
+
+#endif
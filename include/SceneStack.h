@@ -0,0 +1,61 @@
+#ifndef SCENESTACK_H
+#define SCENESTACK_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "Scene.h"
+#include "RenderLayer.h"
+
+// Stack of screens; only the top one does any work. push/pop/reset are queued
+// and applied between frames by applyChanges(), so a scene can change the stack
+// from its own update() without being destroyed under itself.
+// Static scenes are drawn through one cached RenderLayer, and a scene that shows
+// the scene below gets it as a frozen frame captured once, not a live render.
+class SceneStack {
+private:
+    enum class Change { PUSH, POP, RESET };
+
+    struct PendingChange {
+        Change change;
+        Scene* scene;
+    };
+
+    std::vector<Scene*> scenes; // bottom to top; owned by the caller
+    std::vector<PendingChange> pending;
+    sf::RenderWindow* window;
+
+    RenderLayer staticLayer;
+    Scene* staticLayerScene; // the scene the layer was last drawn for
+
+    sf::Texture frozenFrame;
+    MemoryCharge frozenFrameCharge;
+    sf::Sprite frozenSprite;
+    bool frozenFrameValid;
+
+    void freezeSceneBelow();
+
+public:
+    SceneStack();
+
+    void initialize(sf::RenderWindow* renderWindow);
+
+    void push(Scene* scene);
+    void pop();
+    void reset(Scene* root); // everything popped, 'root' pushed
+    void applyChanges();     // once per frame, before update()
+    bool hasPendingChanges() const { return !pending.empty(); }
+
+    Scene* top() const { return scenes.empty() ? nullptr : scenes.back(); }
+    bool hasFrozenFrame() const { return frozenFrameValid; }
+
+    // Top scene only
+    void handleEvent(const sf::Event& event);
+    void update();
+    void render();
+
+    // Nothing to redraw until the next event
+    bool isIdle() const;
+    void invalidate() { staticLayer.markDirty(); } // the window's contents were lost
+};
+
+#endif
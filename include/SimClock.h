@@ -0,0 +1,49 @@
+#ifndef SIMCLOCK_H
+#define SIMCLOCK_H
+
+#include <cstdint>
+#include "TimerWheel.h"
+
+// Simulation time as a tick counter, advanced once per gameplay update.
+// Nothing here reads the OS clock: time stands still while the game is paused
+// (gameplay is simply not updated) and a replay of the same inputs sees the
+// same ticks. The tick count only grows; it is never reset between games.
+class SimClock {
+private:
+    static std::uint32_t tick;
+    static TimerWheel timers;
+
+public:
+    static const int TICKS_PER_SECOND = 60;
+
+    // Advance one tick and fire the timers that are due (call once per gameplay update)
+    static void advance();
+
+    static std::uint32_t now() { return tick; }
+    static TimerWheel& getTimers() { return timers; }
+
+    // Conversions (rounded up, so a cooldown is never shorter than asked)
+    static std::uint32_t millisecondsToTicks(int milliseconds) {
+        return milliseconds <= 0 ? 0 : static_cast<std::uint32_t>((milliseconds * TICKS_PER_SECOND + 999) / 1000);
+    }
+    static float ticksToSeconds(std::uint32_t ticks) { return static_cast<float>(ticks) / TICKS_PER_SECOND; }
+};
+
+// A cooldown is just the tick at which it becomes ready: starting it is one
+// add, checking it is one compare. Starts out ready.
+class Cooldown {
+private:
+    std::uint32_t readyTick;
+
+public:
+    Cooldown() : readyTick(0) {}
+
+    void start(std::uint32_t durationTicks) { readyTick = SimClock::now() + durationTicks; }
+    void startMilliseconds(int milliseconds) { start(SimClock::millisecondsToTicks(milliseconds)); }
+    void reset() { readyTick = 0; }
+
+    bool isReady() const { return SimClock::now() >= readyTick; }
+    std::uint32_t getRemainingTicks() const { return isReady() ? 0 : readyTick - SimClock::now(); }
+};
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef SOUNDBANK_H
+#define SOUNDBANK_H
+
+#include <SFML/Audio.hpp>
+#include <SFML/System.hpp>
+#include <cstdint>
+#include "AssetLoader.h"
+
+enum class SoundId : std::uint8_t {
+    HIT,
+    MAGIC_HIT,
+    SWORD_HIT,
+    PLAYER_HURT,
+    ENEMY_DEATH,
+    COUNT
+};
+
+// Description of one sound effect
+struct SoundEffect {
+    const char* path;
+    std::uint8_t priority; // a request may steal a voice playing something of lower priority
+    float volume;          // 0-100 at the listener
+    float pitchVariation;  // random pitch +- this much, so repeats don't sound identical
+};
+
+// Sound effects for the simulation. Buffers are requested from the AssetLoader
+// once (decoded in the background, retained) and voices are a fixed pool of
+// sf::Sound, so OpenAL sources are created once and playing never allocates one.
+// play() only queues: requests for the same effect within a tick merge into the
+// nearest one, and flush() starts the loudest requests, stealing the voice that
+// matters least (lower priority, then farther away) when the pool is full.
+class SoundBank {
+public:
+    static const int VOICE_COUNT = 16;                  // well under OpenAL's source limit
+    static const int MAX_REQUESTS = static_cast<int>(SoundId::COUNT); // one per effect per tick
+    static constexpr float AUDIBLE_DISTANCE = 700.f;    // pixels; silent beyond, linear fade inside
+
+    static const SoundEffect EFFECTS[static_cast<int>(SoundId::COUNT)];
+
+private:
+    struct Voice {
+        sf::Sound sound;
+        SoundId id;
+        std::uint8_t priority;
+        float distance;
+    };
+
+    struct Request {
+        SoundId id;
+        float distance; // from the listener
+    };
+
+    AssetLoader* assets;
+    AssetLoader::Handle buffers[static_cast<int>(SoundId::COUNT)];
+    Voice voices[VOICE_COUNT];
+    Request requests[MAX_REQUESTS];
+    int requestCount;
+    sf::Vector2f listener; // as of the last flush(); a tick old at most
+    float masterVolume; // 0-100
+    std::uint32_t randomState;
+
+    float randomPitch(float variation);
+    Voice* pickVoice(const SoundEffect& effect, const sf::SoundBuffer& buffer, float distance);
+
+public:
+    SoundBank();
+    ~SoundBank();
+
+    SoundBank(const SoundBank&) = delete;
+    SoundBank& operator=(const SoundBank&) = delete;
+
+    // Requests every effect's buffer; missing files just stay silent
+    void load(AssetLoader& loader);
+
+    void play(SoundId id, sf::Vector2f position);
+
+    // Once per tick, after the simulation queued its sounds
+    void flush(sf::Vector2f listener);
+
+    void stopAll();
+    void setMasterVolume(float volume) { masterVolume = volume; }
+    int getPlayingCount() const;
+};
+
+#endif
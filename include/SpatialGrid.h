@@ -0,0 +1,69 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include <SFML/System.hpp>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Uniform grid over world positions, hashed into a fixed number of buckets so
+// its size does not depend on the world size. rebuild() is a counting sort
+// (O(buckets + items)) and never allocates once reserve() has been called.
+// Items are identified by their index in the positions array passed to rebuild().
+class SpatialGrid {
+private:
+    float cellSize;
+    float inverseCellSize;
+    std::uint32_t bucketMask;
+
+    std::vector<int> bucketStart;           // bucketCount + 1 offsets into the sorted arrays
+    std::vector<int> sortedItems;           // item indices grouped by bucket
+    std::vector<sf::Vector2f> sortedPositions;
+    std::vector<std::uint64_t> sortedCells; // exact cell key, to skip hash collisions
+    std::vector<std::uint32_t> itemBuckets; // scratch for the counting sort
+
+    std::int32_t cellCoord(float value) const { return static_cast<std::int32_t>(std::floor(value * inverseCellSize)); }
+    static std::uint64_t cellKey(std::int32_t cx, std::int32_t cy) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cy)) << 32) | static_cast<std::uint32_t>(cx);
+    }
+    std::uint32_t bucketOf(std::int32_t cx, std::int32_t cy) const {
+        return (static_cast<std::uint32_t>(cx) * 73856093u ^ static_cast<std::uint32_t>(cy) * 19349663u) & bucketMask;
+    }
+
+public:
+    // bucketCount is rounded up to a power of two
+    explicit SpatialGrid(float cellSize = 256.f, int bucketCount = 256);
+
+    void reserve(int maxItems);
+    void rebuild(const sf::Vector2f* positions, int count);
+    void clear();
+    int size() const { return static_cast<int>(sortedItems.size()); }
+    float getCellSize() const { return cellSize; }
+    std::size_t getMemoryBytes() const;
+
+    // Calls f(itemIndex) for every item within radius of center
+    template<typename F>
+    void queryRadius(sf::Vector2f center, float radius, F f) const {
+        if (sortedItems.empty()) return;
+
+        float radiusSq = radius * radius;
+        std::int32_t minX = cellCoord(center.x - radius), maxX = cellCoord(center.x + radius);
+        std::int32_t minY = cellCoord(center.y - radius), maxY = cellCoord(center.y + radius);
+        for (std::int32_t cy = minY; cy <= maxY; cy++) {
+            for (std::int32_t cx = minX; cx <= maxX; cx++) {
+                std::uint32_t bucket = bucketOf(cx, cy);
+                std::uint64_t key = cellKey(cx, cy);
+                for (int i = bucketStart[bucket]; i < bucketStart[bucket + 1]; i++) {
+                    if (sortedCells[i] != key) continue;
+                    float dx = sortedPositions[i].x - center.x;
+                    float dy = sortedPositions[i].y - center.y;
+                    if (dx * dx + dy * dy <= radiusSq) {
+                        f(sortedItems[i]);
+                    }
+                }
+            }
+        }
+    }
+};
+
+#endif
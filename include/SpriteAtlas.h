@@ -0,0 +1,53 @@
+#ifndef SPRITEATLAS_H
+#define SPRITEATLAS_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Where a sprite's animation frames are: a grid of equal frames inside a texture
+// (a whole spritesheet, or that sheet's block in the atlas), row-major.
+struct SpriteFrames {
+    sf::Texture* texture;
+    sf::IntRect area;        // the grid
+    int frameWidth, frameHeight;
+    int frameCount;
+    sf::Vector2f scale;      // sprite scale that gives the intended on-screen size
+
+    // A loose spritesheet, frames drawn at 'scale'
+    static SpriteFrames wholeSheet(sf::Texture* sheet, int frameWidth, int frameHeight, int frameCount,
+                                   sf::Vector2f scale);
+};
+
+// Frame table of the sprite atlas built by tools/AtlasBuilder.cpp: every sheet
+// prescaled to its on-screen size and packed with the tile textures into one
+// texture, so sprites and tiles draw from a single texture binding.
+// Table lines (generated):
+//   <name> <x> <y> <width> <height> <frameWidth> <frameHeight> <frameCount> <scaleX> <scaleY>
+class SpriteAtlas {
+private:
+    struct Entry {
+        std::string name;
+        sf::IntRect area;
+        int frameWidth, frameHeight, frameCount;
+        sf::Vector2f scale;
+    };
+
+    static std::vector<Entry> entries;
+
+    static bool parse(std::istream& input, const std::string& source);
+    static const Entry* find(const std::string& name);
+
+public:
+    static bool load(const std::string& path);
+    static bool loadFromMemory(const unsigned char* data, std::size_t size);
+    static bool isLoaded() { return !entries.empty(); }
+
+    // 'atlas' is the atlas texture; false if the table has no such entry
+    static bool getFrames(const std::string& name, sf::Texture* atlas, SpriteFrames& frames);
+    static bool getRect(const std::string& name, sf::IntRect& rect); // single images (tiles)
+};
+
+#endif
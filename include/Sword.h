@@ -2,16 +2,27 @@
 #define SWORD_H
 
 #include "Weapon.h"
+#include "HitShape.h"
+#include <cstdint>
 
 class Sword : public Weapon {
 private:
+    static constexpr float BLADE_LENGTH = 40.f;
+    static constexpr float SWING_HALF_ARC = 45.f;      // degrees either side of the aim
+    static constexpr float BLADE_HALF_WIDTH_DEG = 6.f; // 4px blade at 40px
+    static constexpr float SLASH_LENGTH = 120.f;
+    static constexpr float SLASH_RADIUS = 10.f;
+
     sf::RectangleShape swordShape;
     sf::Vector2f swingDirection;
-    sf::Clock swingTimer;
+    std::uint32_t swingStartTick; // SimClock tick
     bool isSwinging;
     float swingDuration;
     float swingAngle;
     float baseAngle;
+    std::uint32_t attackCounter; // new id for every swing and slash, for hit registries
+    std::uint32_t swingId;
+    std::uint32_t specialSkillId;
 
     // Special skill properties
     bool isUsingSpecialSkill;
@@ -25,13 +36,17 @@ public:
     // Sword-specific functions
     void startSwing(sf::Vector2f direction);
     bool isSwingActive() const { return isSwinging; }
-    sf::FloatRect getSwingArea() const;
+    sf::FloatRect getSwingArea() const;     // coarse box around the blade's reach
+    HitShape getSwingShape() const;         // the arc swept so far in this swing
+    std::uint32_t getSwingId() const { return swingId; }
     void stopSwing();
 
     // Special skill functions
     void startSpecialSkill(sf::Vector2f direction);
     void stopSpecialSkill();
     sf::FloatRect getSpecialSkillArea() const;
+    HitShape getSpecialSkillShape() const;  // the slash as a capsule
+    std::uint32_t getSpecialSkillId() const { return specialSkillId; }
     bool isSpecialSkillActive() const { return isUsingSpecialSkill; }
     
     // Override getBounds to return sword swing area when swinging
@@ -8,15 +8,19 @@
 
 class Map; // Forward declaration
 
-class SwordHero : public Character {
+class SwordHero : public Character, public TimerListener {
 private:
+    static const int SPECIAL_SKILL_DURATION_MS = 500;
+    enum TimerEvent { EVENT_SPECIAL_SKILL_END };
+
     std::unique_ptr<Sword> sword;
     bool isUsingSpecialSkill;
-    sf::Clock specialSkillTimer;
+    TimerWheel::Handle specialSkillTimer; // ends the special skill
     bool hasUsedSkillBefore;
 
 public:
-    SwordHero();
+    explicit SwordHero(const SpriteFrames* frames = nullptr); // shared preloaded frames, or load our own sheet
+    ~SwordHero();
     void update(const Map* map) override;
     void attack() override { performAttack(); } // chém thường
     void skill() override { performSkill(); }   // vòng chém AOE (unlock lv >= 10)
@@ -26,10 +30,13 @@ protected:
     void executeAttack() override;
     void executeSkill() override;
     void draw(sf::RenderWindow &window) override;
+    void onTimer(int eventId) override;
 
 public:
     // SwordHero-specific functions
     sf::FloatRect getAttackArea() const;
+    bool getAttackShape(HitShape& shape) const; // false when not attacking
+    std::uint32_t getAttackId() const;          // changes with every swing/slash
     bool canUseSkill() const override; // Override for special logic
     bool getIsAttacking() const;
     int getAttackDamage() const { return attackDamage; }
@@ -0,0 +1,31 @@
+#ifndef TILE_H
+#define TILE_H
+
+#include <cstdint>
+
+enum class TileType : std::uint8_t {
+    EMPTY = 0,
+    WALL = 1,
+    DOOR = 2,
+    SPAWN_POINT = 3
+};
+
+// One byte per tile: TileType in the low nibble, flags in the high nibble.
+// Visual data is not stored per tile - it only lives in the render chunks.
+struct Tile {
+    static const std::uint8_t TYPE_MASK = 0x0F;
+    static const std::uint8_t FLAG_BLOCKED = 0x10;
+
+    std::uint8_t bits;
+
+    Tile() : bits(0) {}
+    explicit Tile(TileType type)
+        : bits(static_cast<std::uint8_t>(type) | (type == TileType::WALL ? FLAG_BLOCKED : 0)) {}
+
+    TileType getType() const { return static_cast<TileType>(bits & TYPE_MASK); }
+    bool isPassable() const { return (bits & FLAG_BLOCKED) == 0; }
+};
+
+static_assert(sizeof(Tile) == 1, "Tile must stay one byte");
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <cstdint>
+#include <vector>
+
+// Receives scheduled events. Whoever schedules with 'this' must cancel its
+// pending timers before it is destroyed.
+class TimerListener {
+public:
+    virtual ~TimerListener() {}
+    virtual void onTimer(int eventId) = 0;
+};
+
+// Hierarchical timing wheel over simulation ticks (Varghese & Lauck):
+// 256 one-tick slots, then 64 slots of 256 ticks and 64 slots of 16384 ticks,
+// so schedule/cancel are O(1) and a tick only touches its own slot (plus a
+// cascade of one coarse slot every 256 ticks). Timers live in a fixed pool of
+// intrusive list nodes: nothing allocates after construction.
+class TimerWheel {
+public:
+    typedef std::uint32_t Handle; // 0 = no timer
+
+    static const int LEVEL0_BITS = 8;
+    static const int LEVEL_BITS = 6;
+    static const std::uint32_t MAX_DELAY = (1u << (LEVEL0_BITS + 2 * LEVEL_BITS)) - 1; // ~4.8 hours at 60 Hz
+    static const int DEFAULT_CAPACITY = 1024;
+
+private:
+    static const int LEVEL0_SLOTS = 1 << LEVEL0_BITS;
+    static const int LEVEL_SLOTS = 1 << LEVEL_BITS;
+    static const int SLOT_COUNT = LEVEL0_SLOTS + 2 * LEVEL_SLOTS;
+
+    struct Node {
+        std::uint32_t due;
+        TimerListener* listener;
+        int eventId;
+        int prev, next;   // intrusive list (slot list or free list)
+        int slot;         // -1 when free
+        std::uint16_t generation;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<int> slotHeads; // SLOT_COUNT list heads
+    int freeHead;
+    int activeCount;
+    std::uint32_t currentTick;
+
+    void link(int node, int slot);
+    void unlink(int node);
+    void release(int node);
+    void insert(int node);        // picks the slot from due - currentTick
+    void cascade(int slot);       // re-inserts a coarse slot into finer ones
+
+public:
+    explicit TimerWheel(int capacity = DEFAULT_CAPACITY);
+
+    // Fires listener->onTimer(eventId) delayTicks from now (at least 1 tick).
+    // Returns 0 if the pool is full.
+    Handle schedule(std::uint32_t delayTicks, TimerListener* listener, int eventId);
+    bool cancel(Handle handle);
+    bool isPending(Handle handle) const;
+
+    // Moves time forward one tick at a time, firing due timers in order
+    void advanceTo(std::uint32_t tick);
+
+    void clear();
+    int size() const { return activeCount; }
+    std::uint32_t getCurrentTick() const { return currentTick; }
+};
+
+#endif
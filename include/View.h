@@ -5,21 +5,29 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include "MemoryBudget.h"
 
 // Forward declarations
 class Character;
 class Enemy;
 class Map;
 class Camera;
+class Minimap;
 
 class View {
 private:
     static sf::RenderWindow* window;
+    static sf::RenderTarget* target; // UI drawing goes here: the window, or a RenderLayer being redrawn
     static sf::Font* font;
     static Camera* camera;
+    static sf::Text textObject; // Reused by drawText to avoid rebuilding an sf::Text per call
+    static sf::String textBuffer; // ... and its string, refilled in place (keeps its capacity)
+    static sf::RectangleShape rectangleObject; // Reused by drawRectangle and drawLine
+    static sf::CircleShape circleObject;       // Reused by drawCircle
 
     // Background textures
-    static sf::Texture menuBackgroundTexture;
+    static sf::Texture menuBackgroundTexture; // loadMenuBackground() only
+    static MemoryCharge menuBackgroundCharge;
     static sf::Sprite menuBackgroundSprite;
     static bool menuBackgroundLoaded;
 
@@ -34,6 +42,7 @@ public:
     // Initialization
     static void initialize(sf::RenderWindow* gameWindow, sf::Font* gameFont, Camera* gameCamera = nullptr);
     static void setCamera(Camera* gameCamera);
+    static void setRenderTarget(sf::RenderTarget* renderTarget); // nullptr = back to the window
     
     // Basic rendering
     static void clear(sf::Color color = sf::Color::Black);
@@ -41,13 +50,19 @@ public:
 
     // Background rendering
     static bool loadMenuBackground(const std::string& filepath);
+    static void setMenuBackground(const sf::Texture& texture); // shared, must outlive its use
+    static void clearMenuBackground(); // before the shared texture may go away
+    static bool hasMenuBackground() { return menuBackgroundLoaded; }
     static void drawMenuBackground();
+    static void drawBackground(const sf::Sprite& sprite); // full-screen sprite in the default view
     
     // Text rendering
     static void drawText(const std::string& text, float x, float y, int fontSize = 24, 
                         sf::Color color = sf::Color::White, bool centered = false);
     static void drawText(const std::string& text, sf::Vector2f position, int fontSize = 24, 
                         sf::Color color = sf::Color::White, bool centered = false);
+    static void drawText(const char* text, float x, float y, int fontSize = 24,
+                        sf::Color color = sf::Color::White, bool centered = false);
     
     // Shape rendering
     static void drawRectangle(float x, float y, float width, float height, 
@@ -80,8 +95,7 @@ public:
     
     // HUD rendering
     static void drawHUD(const Character* player, int score, int enemiesKilled, float playTime);
-    static void drawMinimap(const Character* player, const std::vector<Enemy>& enemies, 
-                           float x, float y, float size = 150.f);
+    static void drawMinimap(Minimap& minimap); // frame + cached tiles + markers
     
     // Screen effects
     static void drawFadeOverlay(float alpha = 0.5f, sf::Color color = sf::Color::Black);
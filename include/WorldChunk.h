@@ -0,0 +1,53 @@
+#ifndef WORLDCHUNK_H
+#define WORLDCHUNK_H
+
+#include <cstdint>
+#include <algorithm>
+#include "Tile.h"
+
+// Store tiles in 8x8 blocks with Morton (Z-order) indexing inside each block,
+// so a tile and its neighbours share cache lines. Define as 0 for row-major.
+#ifndef MAP_TILED_LAYOUT
+#define MAP_TILED_LAYOUT 1
+#endif
+
+// Fixed-size square of tiles - the unit of storage, streaming and rendering.
+// Maps store their tiles chunk-major, so a chunk is always 1 KB of contiguous tiles.
+struct WorldChunk {
+    static const int SHIFT = 5;
+    static const int SIZE = 1 << SHIFT; // 32x32 tiles
+    static const int MASK = SIZE - 1;
+    static const int TILE_COUNT = SIZE * SIZE;
+    static const int MAX_SPAWNS = 4;
+    static constexpr std::uint8_t MORTON_3BIT[8] = {0, 1, 4, 5, 16, 17, 20, 21};
+
+    Tile tiles[TILE_COUNT];
+    std::uint16_t spawnTiles[MAX_SPAWNS]; // local tile coordinates packed as (y << SHIFT) | x
+    std::uint8_t spawnCount;
+
+    // Index of a local tile inside a chunk's tile array
+    static int tileIndex(int localX, int localY) {
+#if MAP_TILED_LAYOUT
+        return tiledIndex(localX, localY);
+#else
+        return rowMajorIndex(localX, localY);
+#endif
+    }
+
+    // 4x4 blocks of 8x8 tiles, Morton order inside each block
+    static int tiledIndex(int localX, int localY) {
+        int block = ((localY >> 3) << (SHIFT - 3)) | (localX >> 3);
+        return (block << 6) | MORTON_3BIT[localX & 7] | (MORTON_3BIT[localY & 7] << 1);
+    }
+    static int rowMajorIndex(int localX, int localY) { return (localY << SHIFT) | localX; }
+
+    Tile getTile(int localX, int localY) const { return tiles[tileIndex(localX, localY)]; }
+    void setTile(int localX, int localY, TileType type) { tiles[tileIndex(localX, localY)] = Tile(type); }
+
+    void fill(TileType type) {
+        std::fill(tiles, tiles + TILE_COUNT, Tile(type));
+        spawnCount = 0;
+    }
+};
+
+#endif
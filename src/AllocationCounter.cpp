@@ -0,0 +1,87 @@
+#include "../include/AllocationCounter.h"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#ifndef NDEBUG
+namespace {
+    // Per thread: the chunk streamer and asset loader workers allocate freely
+    // while a tick runs on the main thread
+    thread_local std::size_t threadNewCount = 0;
+}
+
+// Replace the global allocation functions so every heap allocation is counted.
+// The nothrow and array forms in libstdc++ forward to these.
+void* operator new(std::size_t size) {
+    threadNewCount++;
+    if (size == 0) size = 1;
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+#endif
+
+// Static member definitions
+std::size_t AllocationCounter::tickStartCount = 0;
+int AllocationCounter::warmupTicks = AllocationCounter::DEFAULT_WARMUP_TICKS;
+
+bool AllocationCounter::isEnabled() {
+#ifndef NDEBUG
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::size_t AllocationCounter::getCount() {
+#ifndef NDEBUG
+    return threadNewCount;
+#else
+    return 0;
+#endif
+}
+
+void AllocationCounter::resetSteadyState(int warmup) {
+    warmupTicks = warmup;
+}
+
+void AllocationCounter::beginTick() {
+    tickStartCount = getCount();
+}
+
+void AllocationCounter::endTick() {
+#ifndef NDEBUG
+    if (warmupTicks > 0) {
+        warmupTicks--;
+        return;
+    }
+
+    std::size_t allocations = getCount() - tickStartCount;
+    if (allocations != 0) {
+        std::cerr << "Error: " << allocations << " heap allocation(s) during a steady-state gameplay tick" << std::endl;
+    }
+    assert(allocations == 0 && "steady-state gameplay tick must not call global operator new");
+#endif
+}
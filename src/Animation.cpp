@@ -1,37 +1,12 @@
 #include "../include/Animation.h"
 #include "../include/AnimationConfig.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 Animation::Animation() 
-    : texture(nullptr), currentFrame(0), frameTime(0.1f), currentTime(0.0f), isLooping(ANIMATION_ENABLE_LOOP), isFinished(false) {
-}
-
-Animation::Animation(sf::Texture* tex, int frameWidth, int frameHeight, int frameCount, float frameDuration, bool loop)
-    : texture(tex), currentFrame(0), frameTime(frameDuration), currentTime(0.0f), isLooping(loop), isFinished(false) {
-    if (texture) {
-        createFrames(frameWidth, frameHeight, frameCount);
-        
-        // Apply quality settings from config
-        texture->setSmooth(ANIMATION_SMOOTH_TEXTURE);
-        texture->setRepeated(ANIMATION_REPEATED_TEXTURE);
-    }
-}
-
-Animation::~Animation() {
-    // Clear frames trước khi destroy để tránh crash
-    try {
-        // Reset texture reference trước
-        texture = nullptr;
-        
-        // Clear frames một cách an toàn
-        if (!frames.empty()) {
-            frames.clear();
-        }
-    } catch (...) {
-        // Ignore any exceptions during cleanup
-        texture = nullptr;
-        frames.clear();
-    }
+    : frames(nullptr), frameCount(0), texture(nullptr), currentFrame(0), frameTime(0.1f), currentTime(0.0f),
+      isLooping(ANIMATION_ENABLE_LOOP), isFinished(false) {
 }
 
 void Animation::setTexture(sf::Texture* tex) {
@@ -44,39 +19,27 @@ void Animation::setTexture(sf::Texture* tex) {
     }
 }
 
-void Animation::createFrames(int frameWidth, int frameHeight, int frameCount, int startX, int startY) {
-    // Clear frames một cách an toàn
-    try {
-        frames.clear();
-        
-        if (!texture) return;
-        
-        int textureWidth = texture->getSize().x;
-        int textureHeight = texture->getSize().y;
-        
-        // Reserve space để tránh reallocation
-        frames.reserve(frameCount);
-        
-        for (int i = 0; i < frameCount; ++i) {
-            int x = startX + (i * frameWidth) % textureWidth;
-            int y = startY + (i * frameWidth / textureWidth) * frameHeight;
-            
-            // Ensure we don't go out of bounds
-            if (x + frameWidth <= textureWidth && y + frameHeight <= textureHeight) {
-                frames.push_back(sf::IntRect(x, y, frameWidth, frameHeight));
-            }
+void Animation::bindFrames(const FrameRect* table, int tableSize, int firstFrame, int count, const sf::IntRect& area,
+                           int cellWidth, int cellHeight) {
+    frames = nullptr;
+    frameCount = 0;
+    currentFrame = 0;
+    if (firstFrame < 0 || firstFrame >= tableSize || cellWidth <= 0 || cellHeight <= 0) return;
+
+    // Keep the frames whose cells lie inside the area (a sheet may be smaller than its config says)
+    count = std::min(count, tableSize - firstFrame);
+    for (int i = 0; i < count; ++i) {
+        const FrameRect& frame = table[firstFrame + i];
+        if ((frame.column + 1) * cellWidth > area.width || (frame.row + 1) * cellHeight > area.height) {
+            count = i;
+            break;
         }
-        
-        #if ANIMATION_DEBUG_MODE
-        std::cout << "Animation frames created: " << frames.size() << " frames" << std::endl;
-        #endif
-    } catch (...) {
-        // Nếu có lỗi, clear frames và log
-        frames.clear();
-        #if ANIMATION_DEBUG_MODE
-        std::cout << "ERROR: Failed to create animation frames" << std::endl;
-        #endif
     }
+
+    frames = table + firstFrame;
+    frameCount = count;
+    origin = sf::Vector2i(area.left, area.top);
+    cellSize = sf::Vector2i(cellWidth, cellHeight);
 }
 
 void Animation::setFrameTime(float time) {
@@ -88,7 +51,7 @@ void Animation::setLooping(bool loop) {
 }
 
 void Animation::update(float deltaTime) {
-    if (frames.empty()) return;
+    if (frameCount == 0) return;
     
     currentTime += deltaTime;
     
@@ -96,11 +59,11 @@ void Animation::update(float deltaTime) {
         currentTime = 0.0f;
         currentFrame++;
         
-        if (currentFrame >= frames.size()) {
+        if (currentFrame >= frameCount) {
             if (isLooping) {
                 currentFrame = 0;
             } else {
-                currentFrame = frames.size() - 1;
+                currentFrame = frameCount - 1;
                 isFinished = true;
             }
         }
@@ -114,27 +77,38 @@ void Animation::reset() {
 }
 
 sf::IntRect Animation::getCurrentFrame() const {
-    try {
-        // Kiểm tra vector frames có hợp lệ không
-        if (frames.empty()) {
-            return sf::IntRect();
-        }
-        
-        // Kiểm tra currentFrame có trong range không
-        if (currentFrame < 0 || currentFrame >= static_cast<int>(frames.size())) {
-            return sf::IntRect();
-        }
-        
-        // Kiểm tra frame có hợp lệ không
-        if (currentFrame < frames.size()) {
-            return frames[currentFrame];
-        }
-        
+    if (currentFrame < 0 || currentFrame >= frameCount) {
         return sf::IntRect();
-    } catch (...) {
-        // Nếu có exception, return empty rect
+    }
+    
+    // A table lookup; the cell size maps the sheet's grid onto the texture
+    const FrameRect& frame = frames[currentFrame];
+    return sf::IntRect(origin.x + frame.column * cellSize.x, origin.y + frame.row * cellSize.y, cellSize.x, cellSize.y);
+}
+
+int Animation::getFrameIndexAt(float elapsed) const {
+    if (frameCount == 0 || frameTime <= 0.0f) return 0;
+
+    int frame = static_cast<int>(elapsed / frameTime);
+    if (isLooping) {
+        return frame % frameCount;
+    }
+    return std::min(frame, frameCount - 1);
+}
+
+sf::IntRect Animation::getFrameAt(float elapsed) const {
+    if (frameCount == 0) {
         return sf::IntRect();
     }
+
+    const FrameRect& frame = frames[getFrameIndexAt(elapsed)];
+    return sf::IntRect(origin.x + frame.column * cellSize.x, origin.y + frame.row * cellSize.y, cellSize.x, cellSize.y);
+}
+
+float Animation::wrapTime(float elapsed) const {
+    float length = frameTime * frameCount;
+    if (length <= 0.0f || elapsed < length) return elapsed;
+    return isLooping ? std::fmod(elapsed, length) : length;
 }
 
 bool Animation::getIsFinished() const {
@@ -146,11 +120,11 @@ int Animation::getCurrentFrameIndex() const {
 }
 
 int Animation::getFrameCount() const {
-    return frames.size();
+    return frameCount;
 }
 
 void Animation::setCurrentFrame(int frame) {
-    if (frame >= 0 && frame < frames.size()) {
+    if (frame >= 0 && frame < frameCount) {
         currentFrame = frame;
     }
 }
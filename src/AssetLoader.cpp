@@ -0,0 +1,273 @@
+#include "../include/AssetLoader.h"
+#include "../include/AssetPaths.h"
+#include <fstream>
+#include <iostream>
+
+AssetLoader::AssetLoader() : pendingCount(0), useClock(0), budgetWarningShown(false), stopping(false) {
+    worker = std::thread(&AssetLoader::workerLoop, this);
+}
+
+AssetLoader::~AssetLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void AssetLoader::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        workAvailable.wait(lock, [this] { return stopping || !requests.empty(); });
+        if (stopping) return;
+
+        Asset* asset = requests.front();
+        requests.pop_front();
+
+        // Read and decode without holding the lock; nothing else touches the asset meanwhile
+        lock.unlock();
+        if (asset->kind == Kind::TEXTURE) {
+            asset->decoded = asset->packed ? asset->image.loadFromMemory(asset->blob.data, asset->blob.size)
+                                           : asset->image.loadFromFile(AssetPaths::resolve(asset->path));
+        } else {
+            asset->decoded = asset->packed ? asset->sound.loadFromMemory(asset->blob.data, asset->blob.size)
+                                           : asset->sound.loadFromFile(AssetPaths::resolve(asset->path));
+        }
+        lock.lock();
+
+        completed.push_back(asset);
+    }
+}
+
+bool AssetLoader::openPack(const std::string& path) {
+    return pack.open(path);
+}
+
+AssetLoader::Handle AssetLoader::request(const std::string& path, Kind kind) {
+    for (size_t i = 0; i < assets.size(); i++) {
+        if (assets[i]->kind == kind && assets[i]->path == path) {
+            return static_cast<Handle>(i + 1);
+        }
+    }
+
+    auto asset = std::make_unique<Asset>();
+    asset->path = path;
+    asset->kind = kind;
+    asset->charge = MemoryCharge(kind == Kind::SOUND ? MemoryCategory::SOUND : MemoryCategory::TEXTURE);
+    asset->references = 0;
+    asset->lastUsed = useClock;
+    asset->packed = pack.find(path, asset->blob);
+    if (asset->packed && asset->blob.format == ASSET_PACK_FORMAT_RGBA8 && kind != Kind::TEXTURE) {
+        std::cerr << "Warning: " << path << " is packed as an image" << std::endl;
+        asset->packed = false; // fall back to the loose file
+    }
+
+    queue(*asset);
+    assets.push_back(std::move(asset));
+    return static_cast<Handle>(assets.size());
+}
+
+void AssetLoader::queue(Asset& asset) {
+    asset.status = Status::PENDING;
+    asset.decoded = false;
+    pendingCount++;
+
+    if (asset.packed && asset.blob.format == ASSET_PACK_FORMAT_RGBA8) {
+        // Already pixels: nothing for the worker to do
+        asset.decoded = true;
+        uploads.push_back(&asset);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        requests.push_back(&asset);
+    }
+    workAvailable.notify_one();
+}
+
+AssetLoader::Handle AssetLoader::requestTexture(const std::string& path) {
+    return request(path, Kind::TEXTURE);
+}
+
+AssetLoader::Handle AssetLoader::requestSound(const std::string& path) {
+    return request(path, Kind::SOUND);
+}
+
+AssetLoader::Handle AssetLoader::loadTextureNow(const std::string& path) {
+    for (size_t i = 0; i < assets.size(); i++) {
+        if (assets[i]->kind == Kind::TEXTURE && assets[i]->path == path) {
+            return static_cast<Handle>(i + 1);
+        }
+    }
+
+    auto asset = std::make_unique<Asset>();
+    asset->path = path;
+    asset->kind = Kind::TEXTURE;
+    asset->status = Status::PENDING;
+    asset->references = 0;
+    asset->lastUsed = useClock;
+    asset->packed = pack.find(path, asset->blob);
+    if (asset->packed && asset->blob.format == ASSET_PACK_FORMAT_RAW) {
+        asset->decoded = asset->image.loadFromMemory(asset->blob.data, asset->blob.size);
+    } else if (!asset->packed) {
+        asset->decoded = asset->image.loadFromFile(AssetPaths::resolve(path));
+    } else {
+        asset->decoded = true;
+    }
+
+    pendingCount++;
+    finish(*asset, asset->decoded && upload(*asset));
+    assets.push_back(std::move(asset));
+    return static_cast<Handle>(assets.size());
+}
+
+bool AssetLoader::upload(Asset& asset) {
+    if (asset.packed && asset.blob.format == ASSET_PACK_FORMAT_RGBA8) {
+        // Straight from the mapping to the GPU
+        makeRoom(static_cast<std::size_t>(asset.blob.width) * asset.blob.height * 4);
+        if (!asset.texture.create(asset.blob.width, asset.blob.height)) return false;
+        asset.texture.update(asset.blob.data);
+        return true;
+    }
+
+    makeRoom(static_cast<std::size_t>(asset.image.getSize().x) * asset.image.getSize().y * 4);
+    bool ok = asset.texture.loadFromImage(asset.image);
+    asset.image = sf::Image();
+    return ok;
+}
+
+void AssetLoader::finish(Asset& asset, bool ok) {
+    asset.status = ok ? Status::READY : Status::FAILED;
+    pendingCount--;
+    if (!ok) {
+        std::cerr << "Warning: Could not load " << asset.path << std::endl;
+    } else if (asset.kind == Kind::TEXTURE) {
+        asset.charge.set(asset.texture);
+    } else {
+        makeRoom(MemoryBudget::bytesOf(asset.sound));
+        asset.charge.set(asset.sound);
+    }
+}
+
+void AssetLoader::makeRoom(std::size_t bytes) {
+    while (MemoryBudget::exceeds(bytes) && evictLeastRecentlyUsed()) {
+    }
+    if (MemoryBudget::exceeds(bytes) && !budgetWarningShown) {
+        std::cerr << "Warning: over the memory budget with nothing left to evict" << std::endl;
+        budgetWarningShown = true;
+    }
+}
+
+bool AssetLoader::evictLeastRecentlyUsed() {
+    Asset* victim = nullptr;
+    for (const auto& asset : assets) {
+        if (asset->status != Status::READY || asset->references > 0 || asset->charge.getBytes() == 0) continue;
+        if (!victim || asset->lastUsed < victim->lastUsed) victim = asset.get();
+    }
+    if (!victim) return false;
+
+    victim->texture = sf::Texture();
+    victim->sound = sf::SoundBuffer();
+    victim->charge.release();
+    victim->status = Status::EVICTED;
+    MemoryBudget::recordEviction();
+    std::cout << "Evicted " << victim->path << " (memory budget)" << std::endl;
+    return true;
+}
+
+void AssetLoader::update() {
+    useClock++;
+    if (MemoryBudget::exceeds()) {
+        makeRoom(0); // render textures and other owners count against the budget too
+    }
+    if (pendingCount == 0) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        integrating.swap(completed);
+    }
+    for (Asset* asset : integrating) {
+        if (asset->kind == Kind::TEXTURE && asset->decoded) {
+            uploads.push_back(asset);
+        } else {
+            finish(*asset, asset->decoded);
+        }
+    }
+    integrating.clear();
+
+    // Uploads are the only part that has to run here; spread them over frames
+    for (int i = 0; i < UPLOADS_PER_UPDATE && !uploads.empty(); i++) {
+        Asset* asset = uploads.front();
+        uploads.pop_front();
+        finish(*asset, upload(*asset));
+    }
+}
+
+AssetLoader::Asset* AssetLoader::find(Handle handle) const {
+    return handle > 0 && handle <= static_cast<Handle>(assets.size()) ? assets[handle - 1].get() : nullptr;
+}
+
+AssetLoader::Status AssetLoader::getStatus(Handle handle) const {
+    const Asset* asset = find(handle);
+    return asset ? asset->status : Status::FAILED;
+}
+
+AssetLoader::Asset* AssetLoader::use(Handle handle, Kind kind) {
+    Asset* asset = find(handle);
+    if (!asset || asset->kind != kind) return nullptr;
+
+    asset->lastUsed = useClock;
+    if (asset->status == Status::EVICTED) {
+        queue(*asset); // back in a few frames
+    }
+    return asset->status == Status::PENDING ? nullptr : asset;
+}
+
+sf::Texture* AssetLoader::getTexture(Handle handle) {
+    Asset* asset = use(handle, Kind::TEXTURE);
+    return asset ? &asset->texture : nullptr;
+}
+
+const sf::SoundBuffer* AssetLoader::getSound(Handle handle) {
+    Asset* asset = use(handle, Kind::SOUND);
+    return asset ? &asset->sound : nullptr;
+}
+
+void AssetLoader::retain(Handle handle) {
+    if (Asset* asset = find(handle)) {
+        asset->references++;
+    }
+}
+
+void AssetLoader::release(Handle handle) {
+    Asset* asset = find(handle);
+    if (asset && asset->references > 0) {
+        asset->references--;
+    }
+}
+
+bool AssetLoader::exists(const std::string& path) const {
+    AssetPack::Blob blob;
+    return pack.find(path, blob) || std::ifstream(AssetPaths::resolve(path)).good();
+}
+
+bool AssetLoader::getFileData(const std::string& path, const unsigned char*& data, std::size_t& size) const {
+    AssetPack::Blob blob;
+    if (!pack.find(path, blob) || blob.format != ASSET_PACK_FORMAT_RAW) return false;
+    data = blob.data;
+    size = blob.size;
+    return true;
+}
+
+float AssetLoader::getProgress(const std::vector<Handle>& handles) const {
+    if (handles.empty()) return 1.f;
+
+    int done = 0;
+    for (Handle handle : handles) {
+        if (isDone(handle)) done++;
+    }
+    return static_cast<float>(done) / handles.size();
+}
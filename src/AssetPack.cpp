@@ -0,0 +1,110 @@
+#include "../include/AssetPack.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <iostream>
+
+AssetPack::AssetPack() : entries(nullptr), entryCount(0) {
+}
+
+bool AssetPack::open(const std::string& path) {
+    entries = nullptr;
+    entryCount = 0;
+    if (!file.open(path)) {
+        return false;
+    }
+
+    const unsigned char* data = file.getData();
+    std::uint64_t size = file.getSize();
+    AssetPackHeader header;
+    if (size < sizeof(header)) {
+        std::cerr << "Asset pack " << path << " is truncated" << std::endl;
+        file.close();
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+
+    if (std::memcmp(header.magic, ASSET_PACK_MAGIC, sizeof(header.magic)) != 0 || header.version != ASSET_PACK_VERSION) {
+        std::cerr << "Asset pack " << path << " has an unsupported format or version" << std::endl;
+        file.close();
+        return false;
+    }
+
+    // The index is used in place, so it must be aligned and every blob inside the file
+    std::uint64_t indexSize = static_cast<std::uint64_t>(header.entryCount) * sizeof(AssetPackEntry);
+    if (header.indexOffset % ASSET_PACK_ALIGNMENT != 0 || !file.contains(header.indexOffset, indexSize)) {
+        std::cerr << "Asset pack " << path << " is corrupt" << std::endl;
+        file.close();
+        return false;
+    }
+    const AssetPackEntry* index = reinterpret_cast<const AssetPackEntry*>(data + header.indexOffset);
+    for (std::uint32_t i = 0; i < header.entryCount; i++) {
+        const AssetPackEntry& entry = index[i];
+        bool badPixels = entry.format == ASSET_PACK_FORMAT_RGBA8 &&
+                         entry.size != static_cast<std::uint64_t>(entry.width) * entry.height * 4;
+        if (!file.contains(entry.offset, entry.size) || badPixels || (i > 0 && index[i - 1].nameHash >= entry.nameHash)) {
+            std::cerr << "Asset pack " << path << " has a bad index" << std::endl;
+            file.close();
+            return false;
+        }
+    }
+
+    entries = index;
+    entryCount = header.entryCount;
+    std::cout << "Asset pack " << path << ": " << entryCount << " assets" << std::endl;
+    return true;
+}
+
+bool AssetPack::find(const std::string& name, Blob& blob) const {
+    if (!entries) return false;
+
+    std::uint64_t hash = hashName(normalizeName(name));
+    const AssetPackEntry* end = entries + entryCount;
+    const AssetPackEntry* entry = std::lower_bound(entries, end, hash,
+        [](const AssetPackEntry& e, std::uint64_t h) { return e.nameHash < h; });
+    if (entry == end || entry->nameHash != hash) {
+        return false;
+    }
+
+    blob.data = file.getData() + entry->offset;
+    blob.size = static_cast<std::size_t>(entry->size);
+    blob.format = entry->format;
+    blob.width = entry->width;
+    blob.height = entry->height;
+    return true;
+}
+
+std::string AssetPack::normalizeName(const std::string& path) {
+    std::string name = path;
+    for (char& c : name) {
+        c = c == '\\' ? '/' : static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    // Names are relative to the assets directory, wherever the caller thinks it is
+    std::size_t assetsDir = name.rfind("assets/");
+    if (assetsDir != std::string::npos && (assetsDir == 0 || name[assetsDir - 1] == '/')) {
+        return name.substr(assetsDir + 7);
+    }
+
+    // Otherwise just drop leading ./ and ../
+    std::size_t start = 0;
+    while (true) {
+        if (name.compare(start, 2, "./") == 0) {
+            start += 2;
+        } else if (name.compare(start, 3, "../") == 0) {
+            start += 3;
+        } else {
+            break;
+        }
+    }
+    return name.substr(start);
+}
+
+std::uint64_t AssetPack::hashName(const std::string& normalizedName) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : normalizedName) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
@@ -0,0 +1,67 @@
+#include "../include/AssetPaths.h"
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+std::string getExecutablePath() {
+    char buffer[4096];
+#ifdef _WIN32
+    DWORD length = GetModuleFileNameA(nullptr, buffer, sizeof(buffer));
+    if (length == 0 || length >= sizeof(buffer)) return "";
+#else
+    ssize_t length = readlink("/proc/self/exe", buffer, sizeof(buffer));
+    if (length <= 0 || static_cast<size_t>(length) >= sizeof(buffer)) return "";
+#endif
+    return std::string(buffer, static_cast<size_t>(length));
+}
+
+bool directoryExists(const std::string& path) {
+#ifdef _WIN32
+    DWORD attributes = GetFileAttributesA(path.c_str());
+    return attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY);
+#else
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+#endif
+}
+
+// "C:\game\bin\game.exe" -> "C:\game\bin\", "C:\game\bin\" -> "C:\game\"
+std::string parentDirectory(const std::string& path) {
+    std::string trimmed = path;
+    if (!trimmed.empty() && (trimmed.back() == '/' || trimmed.back() == '\\')) trimmed.pop_back();
+    size_t slash = trimmed.find_last_of("/\\");
+    return slash == std::string::npos ? "" : trimmed.substr(0, slash + 1);
+}
+
+} // namespace
+
+std::string AssetPaths::findRoot() {
+    std::string executableDirectory = parentDirectory(getExecutablePath());
+    if (!executableDirectory.empty()) {
+        if (directoryExists(executableDirectory + "assets")) return executableDirectory;
+
+        std::string parent = parentDirectory(executableDirectory);
+        if (!parent.empty() && directoryExists(parent + "assets")) return parent;
+    }
+
+    std::cerr << "Warning: no assets folder next to the executable, loading from the working directory" << std::endl;
+    return "";
+}
+
+const std::string& AssetPaths::getRoot() {
+    static const std::string root = findRoot(); // resolved once, thread-safe
+    return root;
+}
+
+std::string AssetPaths::resolve(const std::string& relativePath) {
+    return getRoot() + relativePath;
+}
@@ -121,11 +121,11 @@ bool Character::checkCollision(sf::Vector2f newPosition, const Map* map) const {
 }
 
 bool Character::canAttack() const {
-    return attackCooldown.getElapsedTime().asMilliseconds() > attackCooldownMs;
+    return attackCooldown.isReady();
 }
 
 bool Character::canUseSkill() const {
-    return level >= skillUnlockLevel && skillCooldown.getElapsedTime().asMilliseconds() > skillCooldownMs;
+    return level >= skillUnlockLevel && skillCooldown.isReady();
 }
 
 void Character::handleMovementInput(const Map* map) {
@@ -140,7 +140,7 @@ void Character::handleMovementInput(const Map* map) {
 
 void Character::drawAimIndicator(sf::RenderWindow& window, sf::Color color, float length, float thickness) {
     // Draw aim indicator line
-    sf::RectangleShape aimLine(sf::Vector2f(length, thickness));
+    aimLine.setSize(sf::Vector2f(length, thickness));
     aimLine.setOrigin(0.f, thickness / 2.f);
     aimLine.setPosition(shape.getPosition());
 
@@ -155,14 +155,14 @@ void Character::drawAimIndicator(sf::RenderWindow& window, sf::Color color, floa
 void Character::performAttack() {
     if (!canAttack()) return;
 
-    attackCooldown.restart();
+    attackCooldown.startMilliseconds(attackCooldownMs);
     executeAttack(); // Call derived class implementation
 }
 
 void Character::performSkill() {
     if (!canUseSkill()) return;
 
-    skillCooldown.restart();
+    skillCooldown.startMilliseconds(skillCooldownMs);
     executeSkill(); // Call derived class implementation
 }
 
@@ -170,17 +170,43 @@ void Character::performSkill() {
 
 void Character::setupPlayerAnimation(const std::string& spritesheetPath, int frameWidth, int frameHeight, int frameCount) {
     if (loadTexture(spritesheetPath)) {
-        // Create animation with the loaded texture using config values
-        Animation* anim = new Animation(&texture, frameWidth, frameHeight, frameCount, PLAYER_FRAME_DURATION, ANIMATION_ENABLE_LOOP);
+        SpriteFrames frames = SpriteFrames::wholeSheet(&ownTexture->texture, frameWidth, frameHeight, frameCount,
+                                                       sf::Vector2f(PLAYER_SHEET.scaleX, PLAYER_SHEET.scaleY));
+        setupPlayerAnimation(&frames);
+        #if ANIMATION_DEBUG_MODE
+        std::cout << "Player texture loaded: " << spritesheetPath << std::endl;
+        #endif
+    } else {
+        #if ANIMATION_DEBUG_MODE
+        std::cout << "ERROR: Failed to load player texture: " << spritesheetPath << std::endl;
+        #endif
+    }
+}
+
+void Character::setupPlayerAnimation(const SpriteFrames* frames) {
+    if (!frames) {
+        setupPlayerAnimation(PLAYER_SHEET.path, PLAYER_SHEET.frameWidth, PLAYER_SHEET.frameHeight, PLAYER_SHEET.frameCount);
+        return;
+    }
+    int frameWidth = frames->frameWidth;
+    int frameHeight = frames->frameHeight;
+    int frameCount = frames->frameCount;
+    if (frames->texture && frames->texture->getSize().x > 0) { // an empty sheet means the asset loader couldn't load it
+        // Animation over the compile-time frame table, mapped onto the sheet or atlas block
+        Animation* anim = new Animation();
+        anim->setTexture(frames->texture);
+        anim->setFrameTime(PLAYER_SHEET.frameDuration);
+        anim->setLooping(ANIMATION_ENABLE_LOOP);
+        anim->setFrames(PLAYER_FRAMES, 0, frameCount, frames->area, frameWidth, frameHeight);
         setAnimation(anim);
         enableAnimation(true);
         
         // Set sprite texture and origin
-        sprite.setTexture(texture);
+        sprite.setTexture(*frames->texture);
         sprite.setOrigin(frameWidth / 2.0f, frameHeight / 2.0f);
         
-        // Apply scale from config to make texture fit game window
-        setAnimationScale(PLAYER_ANIMATION_SCALE_X, PLAYER_ANIMATION_SCALE_Y);
+        // Scale to the on-screen size (a prescaled atlas block is drawn at about 1:1)
+        setAnimationScale(frames->scale.x, frames->scale.y);
         
         // Set texture quality settings
         if (currentAnimation) {
@@ -193,15 +219,14 @@ void Character::setupPlayerAnimation(const std::string& spritesheetPath, int fra
         
         #if ANIMATION_DEBUG_MODE
         std::cout << "Player animation setup: " << frameWidth << "x" << frameHeight 
-                  << " frames: " << frameCount << " scale: " << PLAYER_ANIMATION_SCALE_X 
-                  << "x" << PLAYER_ANIMATION_SCALE_Y << std::endl;
-        std::cout << "Player texture loaded: " << spritesheetPath << std::endl;
+                  << " frames: " << frameCount << " scale: " << frames->scale.x 
+                  << "x" << frames->scale.y << std::endl;
         std::cout << "Player sprite texture: " << (sprite.getTexture() ? "OK" : "NULL") << std::endl;
         std::cout << "Player animation enabled: " << (useAnimation ? "YES" : "NO") << std::endl;
         #endif
     } else {
         #if ANIMATION_DEBUG_MODE
-        std::cout << "ERROR: Failed to load player texture: " << spritesheetPath << std::endl;
+        std::cout << "ERROR: Player spritesheet is empty" << std::endl;
         #endif
     }
 }
@@ -0,0 +1,190 @@
+#include "../include/ChunkStreamer.h"
+#include <algorithm>
+#include <cstdlib>
+
+ChunkStreamer::ChunkStreamer(int chunksX, int chunksY, ChunkSource source, int residentBudget, int loadRadius)
+    : chunksX(chunksX), chunksY(chunksY), loadRadius(loadRadius), source(source),
+      frame(1), nextSerial(1), requestHead(0), requestCount(0), stopping(false) {
+
+    // The budget must at least hold everything inside the keep radius
+    int keepDiameter = 2 * (loadRadius + 1) + 1;
+    residentBudget = std::max(residentBudget, keepDiameter * keepDiameter);
+    residentBudget = std::min(residentBudget, 0x7FFF); // directory stores int16 slot indices
+
+    slots.resize(residentBudget);
+    for (auto& slot : slots) {
+        slot.chunkIndex = -1;
+        slot.serial = 0;
+        slot.lastNeededFrame = 0;
+    }
+    directory.assign(static_cast<std::size_t>(chunksX) * chunksY, NOT_RESIDENT);
+
+    // Everything the worker hand-off needs is allocated up front
+    requestRing.assign(STAGING_BUFFERS, 0);
+    staging.resize(STAGING_BUFFERS);
+    for (int i = STAGING_BUFFERS - 1; i >= 0; i--) {
+        freeStaging.push_back(i);
+    }
+    completed.reserve(STAGING_BUFFERS);
+    integrating.reserve(STAGING_BUFFERS);
+
+    worker = std::thread(&ChunkStreamer::workerLoop, this);
+}
+
+ChunkStreamer::~ChunkStreamer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void ChunkStreamer::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        workAvailable.wait(lock, [this] { return stopping || (requestCount > 0 && !freeStaging.empty()); });
+        if (stopping) return;
+
+        int chunkIndex = requestRing[requestHead];
+        requestHead = (requestHead + 1) % STAGING_BUFFERS;
+        requestCount--;
+        int stagingIndex = freeStaging.back();
+        freeStaging.pop_back();
+
+        // Produce the chunk without holding the lock
+        lock.unlock();
+        WorldChunk& chunk = staging[stagingIndex];
+        source(chunkIndex % chunksX, chunkIndex / chunksX, chunk);
+        lock.lock();
+
+        completed.push_back({chunkIndex, stagingIndex});
+    }
+}
+
+void ChunkStreamer::requestChunk(int chunkIndex) {
+    // Caller holds the mutex and has checked there is room in the ring
+    requestRing[(requestHead + requestCount) % STAGING_BUFFERS] = chunkIndex;
+    requestCount++;
+    directory[chunkIndex] = REQUESTED;
+}
+
+int ChunkStreamer::acquireSlot() {
+    // Free slot first, otherwise evict the least recently needed chunk
+    int victim = -1;
+    for (size_t i = 0; i < slots.size(); i++) {
+        if (slots[i].chunkIndex < 0) {
+            return static_cast<int>(i);
+        }
+        if (slots[i].lastNeededFrame != frame &&
+            (victim < 0 || slots[i].lastNeededFrame < slots[victim].lastNeededFrame)) {
+            victim = static_cast<int>(i);
+        }
+    }
+
+    if (victim >= 0) {
+        directory[slots[victim].chunkIndex] = NOT_RESIDENT;
+        slots[victim].chunkIndex = -1;
+    }
+    return victim;
+}
+
+void ChunkStreamer::integrate(int chunkIndex, const WorldChunk& chunk) {
+    int slot = acquireSlot();
+    if (slot < 0) {
+        // Every resident chunk is still needed - drop the load, it will be requested again
+        directory[chunkIndex] = NOT_RESIDENT;
+        return;
+    }
+
+    slots[slot].chunkIndex = chunkIndex;
+    slots[slot].serial = nextSerial++;
+    slots[slot].lastNeededFrame = frame;
+    slots[slot].chunk = chunk;
+    directory[chunkIndex] = static_cast<std::int16_t>(slot);
+}
+
+bool ChunkStreamer::update(int focusChunkX, int focusChunkY) {
+    frame++;
+    bool changed = false;
+
+    // Mark what is still needed (keep radius is one ring wider than the load radius)
+    int keepRadius = loadRadius + 1;
+    for (int cy = std::max(0, focusChunkY - keepRadius); cy <= std::min(chunksY - 1, focusChunkY + keepRadius); cy++) {
+        for (int cx = std::max(0, focusChunkX - keepRadius); cx <= std::min(chunksX - 1, focusChunkX + keepRadius); cx++) {
+            std::int16_t slot = directory[cy * chunksX + cx];
+            if (slot >= 0) {
+                slots[slot].lastNeededFrame = frame;
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // Take finished loads
+        integrating.swap(completed);
+        completed.clear();
+
+        // Queue missing chunks, nearest rings first
+        for (int ring = 0; ring <= loadRadius && requestCount < STAGING_BUFFERS; ring++) {
+            for (int cy = focusChunkY - ring; cy <= focusChunkY + ring && requestCount < STAGING_BUFFERS; cy++) {
+                for (int cx = focusChunkX - ring; cx <= focusChunkX + ring && requestCount < STAGING_BUFFERS; cx++) {
+                    bool onRing = std::abs(cx - focusChunkX) == ring || std::abs(cy - focusChunkY) == ring;
+                    if (!onRing || cx < 0 || cy < 0 || cx >= chunksX || cy >= chunksY) continue;
+
+                    int chunkIndex = cy * chunksX + cx;
+                    if (directory[chunkIndex] == NOT_RESIDENT) {
+                        requestChunk(chunkIndex);
+                    }
+                }
+            }
+        }
+    }
+
+    // Copy finished chunks into resident slots (staging buffers are not reused until freed below)
+    for (const auto& load : integrating) {
+        integrate(load.chunkIndex, staging[load.stagingIndex]);
+        changed = true;
+    }
+
+    if (!integrating.empty()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& load : integrating) {
+            freeStaging.push_back(load.stagingIndex);
+        }
+    }
+    integrating.clear();
+
+    workAvailable.notify_one();
+    return changed;
+}
+
+void ChunkStreamer::prefetch(int focusChunkX, int focusChunkY, int radius) {
+    frame++;
+    WorldChunk chunk;
+    for (int cy = std::max(0, focusChunkY - radius); cy <= std::min(chunksY - 1, focusChunkY + radius); cy++) {
+        for (int cx = std::max(0, focusChunkX - radius); cx <= std::min(chunksX - 1, focusChunkX + radius); cx++) {
+            int chunkIndex = cy * chunksX + cx;
+            if (directory[chunkIndex] != NOT_RESIDENT) continue; // resident or in flight
+
+            source(cx, cy, chunk);
+            integrate(chunkIndex, chunk);
+        }
+    }
+}
+
+int ChunkStreamer::getResidentCount() const {
+    int count = 0;
+    for (const auto& slot : slots) {
+        if (slot.chunkIndex >= 0) count++;
+    }
+    return count;
+}
+
+std::size_t ChunkStreamer::getMemoryBytes() const {
+    return slots.size() * sizeof(Slot) + staging.size() * sizeof(WorldChunk) +
+           directory.size() * sizeof(std::int16_t);
+}
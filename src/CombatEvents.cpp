@@ -0,0 +1,26 @@
+#include "../include/CombatEvents.h"
+#include <algorithm>
+
+CombatEventQueue::CombatEventQueue(int capacity) {
+    damageEvents.reserve(capacity);
+    killEvents.reserve(capacity / 4);
+}
+
+void CombatEventQueue::append(const CombatEventQueue& other) {
+    damageEvents.insert(damageEvents.end(), other.damageEvents.begin(), other.damageEvents.end());
+    killEvents.insert(killEvents.end(), other.killEvents.begin(), other.killEvents.end());
+}
+
+void CombatEventQueue::sortDamage() {
+    // One packed integer key per event: target, then source, then emitter order
+    auto key = [](const DamageEvent& e) {
+        return (static_cast<std::uint64_t>(e.target) << 24) | (static_cast<std::uint64_t>(e.source) << 16) | e.order;
+    };
+    std::sort(damageEvents.begin(), damageEvents.end(),
+              [&key](const DamageEvent& a, const DamageEvent& b) { return key(a) < key(b); });
+}
+
+void CombatEventQueue::clear() {
+    damageEvents.clear();
+    killEvents.clear();
+}
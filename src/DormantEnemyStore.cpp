@@ -0,0 +1,86 @@
+#include "../include/DormantEnemyStore.h"
+#include "../include/Map.h"
+#include <cmath>
+
+DormantEnemyStore::DormantEnemyStore(int capacity)
+    : capacity(capacity), grid(512.f, 1024), rng(12345u) {
+    positions.reserve(capacity);
+    hp.reserve(capacity);
+    heading.reserve(capacity);
+    archetype.reserve(capacity);
+    wakeScratch.reserve(capacity);
+    grid.reserve(capacity);
+}
+
+void DormantEnemyStore::clear() {
+    positions.clear();
+    hp.clear();
+    heading.clear();
+    archetype.clear();
+    grid.clear();
+}
+
+void DormantEnemyStore::removeAt(int index) {
+    int last = size() - 1;
+    if (index != last) {
+        positions[index] = positions[last];
+        hp[index] = hp[last];
+        heading[index] = heading[last];
+        archetype[index] = archetype[last];
+    }
+    positions.pop_back();
+    hp.pop_back();
+    heading.pop_back();
+    archetype.pop_back();
+}
+
+void DormantEnemyStore::add(sf::Vector2f position, int hitPoints, int archetypeIndex, sf::Vector2f focus) {
+    if (size() >= capacity) {
+        // Full: forget the one farthest from the focus (the only place enemies are really deleted)
+        int farthest = 0;
+        float farthestDistSq = -1.f;
+        for (int i = 0; i < size(); i++) {
+            float dx = positions[i].x - focus.x;
+            float dy = positions[i].y - focus.y;
+            if (dx * dx + dy * dy > farthestDistSq) {
+                farthestDistSq = dx * dx + dy * dy;
+                farthest = i;
+            }
+        }
+        removeAt(farthest);
+    }
+
+    positions.push_back(position);
+    hp.push_back(static_cast<std::int16_t>(hitPoints));
+    heading.push_back(static_cast<std::uint8_t>(rng()));
+    archetype.push_back(static_cast<std::uint8_t>(archetypeIndex));
+    grid.rebuild(positions.data(), size());
+}
+
+void DormantEnemyStore::update(const Map* map, float dt, float speed) {
+    const float stepLength = speed * dt;
+    const float radiansPerStep = 6.2831853f / 256.f;
+
+    for (int i = 0; i < size(); i++) {
+        // Wander: drift along a heading that turns a little each update.
+        // One passability probe at the destination, no sliding along walls.
+        heading[i] = static_cast<std::uint8_t>(heading[i] + static_cast<int>(rng() % 33) - 16);
+        float angle = heading[i] * radiansPerStep;
+        sf::Vector2f next(positions[i].x + std::cos(angle) * stepLength,
+                          positions[i].y + std::sin(angle) * stepLength);
+
+        if (!map || map->isPassable(next)) {
+            positions[i] = next;
+        } else {
+            heading[i] = static_cast<std::uint8_t>(heading[i] + 128); // turn around
+        }
+    }
+
+    grid.rebuild(positions.data(), size());
+}
+
+std::size_t DormantEnemyStore::getMemoryBytes() const {
+    return positions.capacity() * sizeof(sf::Vector2f) + hp.capacity() * sizeof(std::int16_t) +
+           (heading.capacity() + archetype.capacity()) * sizeof(std::uint8_t) + wakeScratch.capacity() * sizeof(int) +
+           grid.getMemoryBytes();
+}
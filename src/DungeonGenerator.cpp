@@ -0,0 +1,327 @@
+#include "../include/DungeonGenerator.h"
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+
+DungeonGenerator::DungeonGenerator(int width, int height, unsigned int seed, const DungeonSettings& settings)
+    : width(width), height(height), settings(settings), rng(seed),
+      start{width / 2, height / 2}, doorCount(0), sealedCount(0) {
+}
+
+int DungeonGenerator::randomRange(int minValue, int maxValue) {
+    if (maxValue <= minValue) return minValue;
+    return minValue + static_cast<int>(rng() % static_cast<unsigned int>(maxValue - minValue + 1));
+}
+
+template<typename F>
+void DungeonGenerator::forEachRowBand(F f) const {
+    int threadCount = settings.threads > 0 ? settings.threads : static_cast<int>(std::thread::hardware_concurrency());
+    threadCount = std::max(1, std::min(threadCount, height / 32)); // not worth a thread below 32 rows
+
+    if (threadCount == 1) {
+        f(0, height);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1);
+    int rowsPerBand = (height + threadCount - 1) / threadCount;
+    for (int band = 1; band < threadCount; band++) {
+        int firstRow = band * rowsPerBand;
+        int endRow = std::min(height, firstRow + rowsPerBand);
+        if (firstRow < endRow) {
+            workers.emplace_back(f, firstRow, endRow);
+        }
+    }
+    f(0, std::min(height, rowsPerBand)); // this thread takes the first band
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void DungeonGenerator::addExit(int x, int y) {
+    exits.push_back({x, y});
+}
+
+bool DungeonGenerator::generate() {
+    tiles.assign(static_cast<std::size_t>(width) * height, TileType::WALL);
+    regions.assign(tiles.size(), 0);
+    nodes.clear();
+    rooms.clear();
+    corridors.clear();
+    spawnTiles.clear();
+    doorCount = 0;
+    sealedCount = 0;
+
+    reachable.clear();
+    start = {width / 2, height / 2};
+
+    // Smaller grids have no room inside the walls, and the start would be a wall
+    if (width < MIN_SIZE || height < MIN_SIZE) return false;
+
+    buildBsp();
+    connectRooms();
+    carve();
+    placeDoors();
+    floodFill();
+    sealUnreachable();
+    sampleSpawns();
+    return true;
+}
+
+void DungeonGenerator::buildBsp() {
+    // Root covers everything inside the outer wall. Children are always pushed
+    // after their parent, so walking the array backwards visits children first.
+    nodes.push_back({{1, 1, width - 2, height - 2}, -1, -1, -1});
+
+    for (size_t i = 0; i < nodes.size(); i++) {
+        Rect area = nodes[i].area;
+        bool canSplitX = area.width >= 2 * settings.minLeafSize;
+        bool canSplitY = area.height >= 2 * settings.minLeafSize;
+        bool tooBig = area.width > settings.maxLeafSize || area.height > settings.maxLeafSize;
+
+        if (tooBig && (canSplitX || canSplitY)) {
+            // Split across the longer side
+            bool splitX = canSplitX && (!canSplitY || area.width >= area.height);
+            Rect first = area;
+            Rect second = area;
+            if (splitX) {
+                int cut = randomRange(settings.minLeafSize, area.width - settings.minLeafSize);
+                first.width = cut;
+                second.x += cut;
+                second.width -= cut;
+            } else {
+                int cut = randomRange(settings.minLeafSize, area.height - settings.minLeafSize);
+                first.height = cut;
+                second.y += cut;
+                second.height -= cut;
+            }
+
+            int leftIndex = static_cast<int>(nodes.size());
+            nodes.push_back({first, -1, -1, -1});
+            nodes.push_back({second, -1, -1, -1});
+            nodes[i].left = leftIndex;
+            nodes[i].right = leftIndex + 1;
+        } else {
+            // Leaf: a room with at least one tile of wall around it
+            int maxWidth = std::max(1, area.width - 2);
+            int maxHeight = std::max(1, area.height - 2);
+            Rect room;
+            room.width = randomRange(std::min(settings.minRoomSize, maxWidth), maxWidth);
+            room.height = randomRange(std::min(settings.minRoomSize, maxHeight), maxHeight);
+            room.x = area.x + 1 + randomRange(0, maxWidth - room.width);
+            room.y = area.y + 1 + randomRange(0, maxHeight - room.height);
+
+            nodes[i].room = static_cast<int>(rooms.size());
+            rooms.push_back(room);
+        }
+    }
+}
+
+void DungeonGenerator::connectRooms() {
+    // Join the two subtrees of every inner node: a spanning tree over all rooms
+    for (int i = static_cast<int>(nodes.size()) - 1; i >= 0; i--) {
+        BspNode& node = nodes[i];
+        if (node.left < 0) continue;
+
+        const Rect& a = rooms[nodes[node.left].room];
+        const Rect& b = rooms[nodes[node.right].room];
+        int ax = a.x + a.width / 2;
+        int ay = a.y + a.height / 2;
+        int bx = b.x + b.width / 2;
+        int by = b.y + b.height / 2;
+        int w = settings.corridorWidth;
+
+        // L-shaped: horizontal leg then vertical leg, or the other way round
+        if (rng() % 2 == 0) {
+            corridors.push_back({std::min(ax, bx), ay, std::abs(bx - ax) + w, w});
+            corridors.push_back({bx, std::min(ay, by), w, std::abs(by - ay) + w});
+        } else {
+            corridors.push_back({ax, std::min(ay, by), w, std::abs(by - ay) + w});
+            corridors.push_back({std::min(ax, bx), by, std::abs(bx - ax) + w, w});
+        }
+
+        node.room = (rng() % 2 == 0) ? nodes[node.left].room : nodes[node.right].room;
+    }
+
+    // Each exit: straight in from the wall, then turn towards the nearest room
+    int w = settings.corridorWidth;
+    for (const TilePos& exit : exits) {
+        const Rect* nearest = &rooms[0];
+        int bestDistance = -1;
+        for (const Rect& room : rooms) {
+            int distance = std::abs(room.x + room.width / 2 - exit.x) + std::abs(room.y + room.height / 2 - exit.y);
+            if (bestDistance < 0 || distance < bestDistance) {
+                bestDistance = distance;
+                nearest = &room;
+            }
+        }
+        int cx = nearest->x + nearest->width / 2;
+        int cy = nearest->y + nearest->height / 2;
+
+        if (exit.x == 0 || exit.x == width - 1) {
+            corridors.push_back({std::min(exit.x, cx), exit.y, std::abs(cx - exit.x) + w, w});
+            corridors.push_back({cx, std::min(exit.y, cy), w, std::abs(cy - exit.y) + w});
+        } else {
+            corridors.push_back({exit.x, std::min(exit.y, cy), w, std::abs(cy - exit.y) + w});
+            corridors.push_back({std::min(exit.x, cx), cy, std::abs(cx - exit.x) + w, w});
+        }
+    }
+}
+
+void DungeonGenerator::carve() {
+    forEachRowBand([this](int firstRow, int endRow) {
+        auto carveRects = [&](const std::vector<Rect>& rects, std::uint8_t region) {
+            for (const Rect& rect : rects) {
+                int y0 = std::max({rect.y, firstRow, 1});
+                int y1 = std::min({rect.y + rect.height, endRow, height - 1});
+                int x0 = std::max(rect.x, 1);
+                int x1 = std::min(rect.x + rect.width, width - 1);
+                for (int y = y0; y < y1; y++) {
+                    for (int x = x0; x < x1; x++) {
+                        tiles[y * width + x] = TileType::EMPTY;
+                        regions[y * width + x] |= region;
+                    }
+                }
+            }
+        };
+        carveRects(rooms, REGION_ROOM);
+        carveRects(corridors, REGION_CORRIDOR);
+
+        // Exits are the only openings in the outer wall
+        for (const TilePos& exit : exits) {
+            bool alongColumn = exit.x == 0 || exit.x == width - 1;
+            for (int i = 0; i < settings.corridorWidth; i++) {
+                int x = alongColumn ? exit.x : exit.x + i;
+                int y = alongColumn ? exit.y + i : exit.y;
+                if (x >= 0 && x < width && y >= firstRow && y < endRow) {
+                    tiles[y * width + x] = TileType::EMPTY;
+                    regions[y * width + x] |= REGION_CORRIDOR;
+                }
+            }
+        }
+    });
+}
+
+void DungeonGenerator::placeDoors() {
+    // A door is a corridor tile just outside a room that the corridor passes
+    // through: room ahead, more corridor behind, and solid rock on at least one
+    // side (so a corridor running along a room's wall does not become a door).
+    // Reads only 'regions' (final after carving) and writes only its own rows.
+    std::vector<int> bandDoors(height, 0);
+    forEachRowBand([this, &bandDoors](int firstRow, int endRow) {
+        static const int DX[4] = {1, -1, 0, 0};
+        static const int DY[4] = {0, 0, 1, -1};
+        int doors = 0;
+        for (int y = std::max(1, firstRow); y < std::min(endRow, height - 1); y++) {
+            for (int x = 1; x < width - 1; x++) {
+                if (regions[y * width + x] != REGION_CORRIDOR) continue;
+                for (int d = 0; d < 4; d++) {
+                    std::uint8_t ahead = regions[(y + DY[d]) * width + (x + DX[d])];
+                    std::uint8_t behind = regions[(y - DY[d]) * width + (x - DX[d])];
+                    std::uint8_t side1 = regions[(y + DX[d]) * width + (x + DY[d])];
+                    std::uint8_t side2 = regions[(y - DX[d]) * width + (x - DY[d])];
+                    if ((ahead & REGION_ROOM) && (behind & REGION_CORRIDOR) && !(behind & REGION_ROOM) &&
+                        (side1 == 0 || side2 == 0)) {
+                        tiles[y * width + x] = TileType::DOOR;
+                        doors++;
+                        break;
+                    }
+                }
+            }
+        }
+        bandDoors[firstRow] = doors;
+    });
+
+    for (int doors : bandDoors) {
+        doorCount += doors;
+    }
+}
+
+void DungeonGenerator::floodFill() {
+    // Start in the room closest to the map centre
+    int bestDistance = -1;
+    for (const Rect& room : rooms) {
+        int cx = room.x + room.width / 2;
+        int cy = room.y + room.height / 2;
+        int distance = std::abs(cx - width / 2) + std::abs(cy - height / 2);
+        if (bestDistance < 0 || distance < bestDistance) {
+            bestDistance = distance;
+            start = {cx, cy};
+        }
+    }
+
+    reachable.clear();
+    if (!isPassableAt(start.x, start.y)) return;
+
+    // BFS; the reachable list doubles as the queue
+    std::vector<std::uint8_t> visited(tiles.size(), 0);
+    reachable.reserve(tiles.size());
+    int startIndex = start.y * width + start.x;
+    visited[startIndex] = 1;
+    reachable.push_back(startIndex);
+
+    for (size_t head = 0; head < reachable.size(); head++) {
+        int index = reachable[head];
+        int x = index % width;
+        int y = index / width;
+        const int neighbours[4] = {index - 1, index + 1, index - width, index + width};
+        const bool valid[4] = {x > 0, x < width - 1, y > 0, y < height - 1};
+        for (int n = 0; n < 4; n++) {
+            if (valid[n] && !visited[neighbours[n]] && tiles[neighbours[n]] != TileType::WALL) {
+                visited[neighbours[n]] = 1;
+                reachable.push_back(neighbours[n]);
+            }
+        }
+    }
+
+    for (int index : reachable) {
+        regions[index] |= REGION_REACHABLE;
+    }
+}
+
+void DungeonGenerator::sealUnreachable() {
+    std::vector<int> bandSealed(height, 0);
+    forEachRowBand([this, &bandSealed](int firstRow, int endRow) {
+        int sealed = 0;
+        for (int index = firstRow * width; index < endRow * width; index++) {
+            if (tiles[index] != TileType::WALL && !(regions[index] & REGION_REACHABLE)) {
+                tiles[index] = TileType::WALL;
+                sealed++;
+            }
+        }
+        bandSealed[firstRow] = sealed;
+    });
+
+    for (int sealed : bandSealed) {
+        sealedCount += sealed;
+    }
+}
+
+void DungeonGenerator::sampleSpawns() {
+    // Random picks from the reachable set: room floor with open space all around,
+    // away from the start
+    int minDistanceSq = settings.minSpawnDistance * settings.minSpawnDistance;
+    int attempts = settings.spawnCount * 16;
+    for (int attempt = 0; attempt < attempts && static_cast<int>(spawnTiles.size()) < settings.spawnCount &&
+                          !reachable.empty(); attempt++) {
+        int index = reachable[rng() % reachable.size()];
+        int x = index % width;
+        int y = index / width;
+
+        if (regions[index] & REGION_CORRIDOR) continue;
+        int dx = x - start.x;
+        int dy = y - start.y;
+        if (dx * dx + dy * dy < minDistanceSq) continue;
+
+        bool open = true;
+        for (int oy = -1; oy <= 1 && open; oy++) {
+            for (int ox = -1; ox <= 1 && open; ox++) {
+                open = isPassableAt(x + ox, y + oy);
+            }
+        }
+        if (open) {
+            spawnTiles.push_back({x, y});
+        }
+    }
+}
@@ -1,231 +1,260 @@
 #include "../include/Enemy.h"
 #include "../include/AnimationConfig.h"
+#include "../include/BaseObject.h"
 #include "../include/Map.h"
 #include <cmath>
 #include <iostream>
 
-Enemy::Enemy(float x, float y) : BaseObject() {
-    shape.setSize(sf::Vector2f(28.f, 28.f)); // Keep for backward compatibility
-    shape.setOrigin(14.f, 14.f); // Center origin
-    shape.setPosition(x, y);
-    shape.setFillColor(sf::Color::Red);
+SpriteFrames Enemy::sheet = {};
+Animation Enemy::clipAnimations[EnemyArchetypes::MAX_CLIPS];
+sf::Sprite Enemy::sprite;
+sf::RectangleShape Enemy::body;
+sf::RectangleShape Enemy::healthBarBack(sf::Vector2f(24.f, 4.f));
+sf::RectangleShape Enemy::healthBarFill;
 
-    speed = 80.f; // pixels per second
-    maxHp = 50;
-    hp = maxHp;
-    damage = 15;
-    // BaseObject already initializes isAlive and texture
+Enemy::Enemy(float x, float y, int archetypeIndex)
+    : position(x, y), isAlive(true), animationTime(0.f) {
+    // Stats live in the archetype table; only mutable state is per enemy
+    archetype = static_cast<std::uint8_t>(
+        (archetypeIndex >= 0 && archetypeIndex < EnemyArchetypes::count()) ? archetypeIndex : 0);
+    static std::uint32_t nextId = 1;
+    id = nextId++;
+
+    hp = getArchetype().maxHp;
 
-    detectionRange = 500.f;
-    attackRange = 20.f; // Increased for better collision
     targetPosition = sf::Vector2f(x, y);
-}
+    alerted = false;
+    attackCooldown.startMilliseconds(ATTACK_COOLDOWN_MS); // no hits right after spawning
 
-Enemy::~Enemy() {
-    // BaseObject destructor sẽ handle animation cleanup
+    steerDirection = sf::Vector2f(0.f, 0.f);
+    avoidance = sf::Vector2f(0.f, 0.f);
+    decisionStale = true;
+    static unsigned char nextLodPhase = 0;
+    lodPhase = nextLodPhase++;
 }
 
-Enemy::Enemy(const Enemy& other) : BaseObject(other) {
-    shape = other.shape;
-    speed = other.speed;
-    hp = other.hp;
-    maxHp = other.maxHp;
-    damage = other.damage;
-    detectionRange = other.detectionRange;
-    attackRange = other.attackRange;
-    targetPosition = other.targetPosition;
-    attackCooldown = other.attackCooldown;
-    
-    // QUAN TRỌNG: Không copy animation - sẽ được setup lại
-    // BaseObject copy constructor đã set currentAnimation = nullptr
-}
-
-Enemy& Enemy::operator=(const Enemy& other) {
-    if (this != &other) {
-        BaseObject::operator=(other);
-        shape = other.shape;
-        speed = other.speed;
-        hp = other.hp;
-        maxHp = other.maxHp;
-        damage = other.damage;
-        detectionRange = other.detectionRange;
-        attackRange = other.attackRange;
-        targetPosition = other.targetPosition;
-        attackCooldown = other.attackCooldown;
-        
-        // QUAN TRỌNG: Không copy animation - sẽ được setup lại
-        // BaseObject assignment operator đã set currentAnimation = nullptr
-    }
-    return *this;
-}
-
-void Enemy::update(sf::Vector2f playerPos, const Map* map) {
+void Enemy::update(sf::Vector2f playerPos, const Map* map, float dt) {
     if (!isAlive) return;
 
-    sf::Vector2f currentPos = shape.getPosition();
+    const EnemyArchetype& type = getArchetype();
+    sf::Vector2f currentPos = position;
     float distanceToPlayer = BaseObject::distanceBetween(currentPos, playerPos);
 
     // AI Behavior: Chase player if in detection range
-    if (distanceToPlayer <= detectionRange) {
+    sf::Vector2f direction(0.f, 0.f);
+    bool chasing = false;
+    float speedScale = 1.f;
+    if (distanceToPlayer <= type.detectionRange) {
         targetPosition = playerPos;
 
-        // Move towards player
-        sf::Vector2f direction = BaseObject::calculateDirection(currentPos, targetPosition);
-
-        if (distanceToPlayer > attackRange) {
-
-            // Calculate new position
-            sf::Vector2f newPosition = currentPos + direction * speed * (1.f/60.f);
+        if (distanceToPlayer > type.attackRange) {
+            // Follow the last steering decision; until the first one, head straight for the player.
+            // The decision may be several ticks old: if a wall is now ahead, ask for a new
+            // one and head straight for the player meanwhile.
+            direction = steerDirection;
+            if (direction.x != 0.f || direction.y != 0.f) {
+                if (map && !map->isPassable(currentPos + direction * STEER_LOOKAHEAD)) {
+                    decisionStale = true;
+                    direction = sf::Vector2f(0.f, 0.f);
+                }
+            }
+            if (direction.x == 0.f && direction.y == 0.f) {
+                direction = BaseObject::calculateDirection(currentPos, targetPosition);
+            }
+            chasing = true;
+        }
 
-            // Simple collision check with map
-            if (map && map->isPassable(newPosition)) {
-                setPosition(newPosition.x, newPosition.y);
+        // Per-type behaviour: a switch over the archetype's id, no virtual calls
+        switch (type.behaviour) {
+        case EnemyBehaviour::CHASE:
+            break;
+        case EnemyBehaviour::CHARGE:
+            speedScale = isDashing() ? CHARGE_DASH_SCALE : CHARGE_REST_SCALE;
+            break;
+        case EnemyBehaviour::AMBUSH:
+            if (!alerted && distanceToPlayer <= type.detectionRange * AMBUSH_TRIGGER_FRACTION) {
+                alerted = true;
+            }
+            if (!alerted) {
+                direction = sf::Vector2f(0.f, 0.f);
+                chasing = false;
             }
+            break;
+        case EnemyBehaviour::COWARD:
+            if (hp * 100 < type.maxHp * COWARD_FLEE_PERCENT) {
+                direction = -BaseObject::calculateDirection(currentPos, playerPos);
+                chasing = false;
+            }
+            break;
         }
 
         // Attack logic will be handled in Game::checkCollisions()
         // Remove duplicate attack logic from here
     }
+
+    // Local avoidance keeps enemies from stacking, even while idle
+    direction += avoidance;
+    float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+    if (length < 0.01f) return;
+    if (length > 1.f) {
+        direction /= length;
+    }
+
+    // Calculate new position (dt grows for enemies updated at a reduced rate)
+    sf::Vector2f newPosition = currentPos + direction * (type.speed * speedScale * dt);
+
+    // Simple collision check with map
+    if (map && map->isPassable(newPosition)) {
+        setPosition(newPosition.x, newPosition.y);
+    } else if (chasing) {
+        decisionStale = true; // ask for a new decision
+    }
 }
 
+void Enemy::think(sf::Vector2f playerPos, const Map* map) {
+    decisionStale = false;
+
+    sf::Vector2f currentPos = position;
+    if (!isAlive || !BaseObject::isInRange(currentPos, playerPos, getArchetype().detectionRange)) {
+        steerDirection = sf::Vector2f(0.f, 0.f);
+        return;
+    }
+
+    // Straight at the player if the way ahead is clear, otherwise the first open
+    // heading rotating away from it (45, -45, 90, -90, 135, -135 degrees)
+    static const float OFFSETS[7] = {0.f, 0.785398f, -0.785398f, 1.570796f, -1.570796f, 2.356194f, -2.356194f};
+    const float lookahead = STEER_LOOKAHEAD;
+    sf::Vector2f direct = BaseObject::calculateDirection(currentPos, playerPos);
+    float baseAngle = std::atan2(direct.y, direct.x);
 
+    for (float offset : OFFSETS) {
+        sf::Vector2f candidate(std::cos(baseAngle + offset), std::sin(baseAngle + offset));
+        if (!map || (map->isPassable(currentPos + candidate * lookahead) &&
+                     map->isPassable(currentPos + candidate * (lookahead * 2.f)))) {
+            steerDirection = candidate;
+            return;
+        }
+    }
 
-void Enemy::draw(sf::RenderWindow &window) {
+    steerDirection = sf::Vector2f(0.f, 0.f); // boxed in - wait for the next decision
+}
+
+
+
+void Enemy::animate(float dt) {
+    animationTime = getClipAnimation().wrapTime(animationTime + dt);
+}
+
+void Enemy::draw(sf::RenderWindow &window) const {
     if (!isAlive) return;
 
-    if (useAnimation && currentAnimation && sprite.getTexture()) {
-        // Draw animated sprite với texture rect để cắt frame
-        sf::Sprite animatedSprite = sprite;
-        animatedSprite.setTextureRect(currentAnimation->getCurrentFrame());
-        window.draw(animatedSprite);
+    const EnemyArchetype& type = getArchetype();
+    float healthPercent = static_cast<float>(hp) / type.maxHp;
+    if (sheet.texture) {
+        // Shared sprite: this enemy's frame, position and type tint
+        sprite.setTextureRect(getClipAnimation().getFrameAt(animationTime));
+        sprite.setPosition(position);
+        sprite.setColor(sf::Color(type.tint)); // one sheet, tinted per enemy type
+        window.draw(sprite);
         
         #if ANIMATION_DEBUG_MODE && ANIMATION_SHOW_FRAME_INFO
         // Debug: hiển thị frame info
         static int lastFrame = -1;
-        int currentFrame = currentAnimation->getCurrentFrameIndex();
+        int currentFrame = getAnimationFrame();
         if (currentFrame != lastFrame) {
-            std::cout << "Enemy frame: " << currentFrame << "/" << currentAnimation->getFrameCount() << std::endl;
+            std::cout << "Enemy frame: " << currentFrame << "/" << getAnimationFrameCount() << std::endl;
             lastFrame = currentFrame;
         }
         #endif
-    } else if (sprite.getTexture()) {
-        // Draw static texture nếu không có animation
-        window.draw(sprite);
     } else {
-        // Fallback to shape
-        // Change color based on health
-        float healthPercent = static_cast<float>(hp) / maxHp;
+        // No sheet: the hitbox, coloured by health
+        body.setSize(sf::Vector2f(type.hitboxWidth, type.hitboxHeight));
+        body.setOrigin(type.hitboxWidth / 2.f, type.hitboxHeight / 2.f);
+        body.setPosition(position);
         if (healthPercent > 0.6f) {
-            shape.setFillColor(sf::Color::Red);
+            body.setFillColor(sf::Color::Red);
         } else if (healthPercent > 0.3f) {
-            shape.setFillColor(sf::Color(255, 165, 0)); // Orange
+            body.setFillColor(sf::Color(255, 165, 0)); // Orange
         } else {
-            shape.setFillColor(sf::Color(139, 0, 0)); // Dark red
+            body.setFillColor(sf::Color(139, 0, 0)); // Dark red
         }
-        window.draw(shape);
+        window.draw(body);
     }
 
     // Draw health bar
-    float healthPercent = static_cast<float>(hp) / maxHp;
-    sf::RectangleShape healthBarBg(sf::Vector2f(24.f, 4.f));
-    healthBarBg.setOrigin(12.f, 2.f);
-    healthBarBg.setPosition(shape.getPosition().x, shape.getPosition().y - 18.f);
-    healthBarBg.setFillColor(sf::Color::Black);
-    window.draw(healthBarBg);
-
-    sf::RectangleShape healthBar(sf::Vector2f(22.f * healthPercent, 2.f));
-    healthBar.setOrigin(11.f * healthPercent, 1.f);
-    healthBar.setPosition(shape.getPosition().x, shape.getPosition().y - 18.f);
-    healthBar.setFillColor(sf::Color::Green);
-    window.draw(healthBar);
+    healthBarBack.setOrigin(12.f, 2.f);
+    healthBarBack.setPosition(position.x, position.y - 18.f);
+    healthBarBack.setFillColor(sf::Color::Black);
+    window.draw(healthBarBack);
+
+    healthBarFill.setSize(sf::Vector2f(22.f * healthPercent, 2.f));
+    healthBarFill.setOrigin(11.f * healthPercent, 1.f);
+    healthBarFill.setPosition(position.x, position.y - 18.f);
+    healthBarFill.setFillColor(sf::Color::Green);
+    window.draw(healthBarFill);
 }
 
 void Enemy::takeDamage(int damageAmount) {
     hp -= damageAmount;
     if (hp <= 0) {
         hp = 0;
-        setAlive(false); // Use BaseObject method
+        isAlive = false;
     }
 }
 
 bool Enemy::canAttack() const {
-    return attackCooldown.getElapsedTime().asMilliseconds() > 500; // 0.5 second cooldown (faster for testing)
+    return attackCooldown.isReady(); // 0.5 second cooldown (faster for testing)
+}
+
+bool Enemy::isDashing() const {
+    // 2 second cycle with a 0.6 second dash, offset per enemy so a pack doesn't dash in sync
+    const std::uint32_t cycle = 2 * SimClock::TICKS_PER_SECOND;
+    const std::uint32_t dash = SimClock::millisecondsToTicks(600);
+    return (SimClock::now() + lodPhase * 7u) % cycle < dash;
 }
 
 bool Enemy::isInAttackRange(sf::Vector2f playerPos) const {
-    sf::Vector2f currentPos = shape.getPosition();
-    return BaseObject::isInRange(currentPos, playerPos, attackRange);
+    sf::Vector2f currentPos = position;
+    return BaseObject::isInRange(currentPos, playerPos, getArchetype().attackRange);
 }
 
 void Enemy::attackPlayer() {
-    attackCooldown.restart();
+    attackCooldown.startMilliseconds(ATTACK_COOLDOWN_MS);
     // Attack animation or sound effect could be added here
 }
 
-void Enemy::setPosition(float x, float y) {
-    // Gọi BaseObject::setPosition trước để set sprite position
-    BaseObject::setPosition(x, y);
+sf::FloatRect Enemy::getBounds() const {
+    const EnemyArchetype& type = getArchetype();
+    return sf::FloatRect(position.x - type.hitboxWidth / 2.f, position.y - type.hitboxHeight / 2.f,
+                         type.hitboxWidth, type.hitboxHeight);
+}
+
+void Enemy::setSpritesheet(const SpriteFrames& sharedFrames) {
+    sheet = SpriteFrames();
+    if (!sharedFrames.texture || sharedFrames.texture->getSize().x == 0) return; // the asset loader couldn't load it
+    sheet = sharedFrames;
+
+    // One frame table per clip. Clips are in source-sheet pixels and whole frames of its
+    // grid; the atlas keeps the grid (prescaled), so a clip's first frame index still holds
+    for (int i = 0; i < EnemyArchetypes::MAX_CLIPS; i++) {
+        const SpriteClip& clip = EnemyArchetypes::getClip(i);
+        int firstFrame = (clip.y / ENEMY_SHEET.frameHeight) * ENEMY_SHEET.columns() + clip.x / ENEMY_SHEET.frameWidth;
+        Animation& animation = clipAnimations[i];
+        animation.setTexture(sheet.texture);
+        animation.setFrameTime(ENEMY_SHEET.frameDuration);
+        animation.setLooping(ANIMATION_ENABLE_LOOP);
+        animation.setFrames(ENEMY_FRAMES, firstFrame, clip.frameCount, sheet.area, sheet.frameWidth, sheet.frameHeight);
+    }
+
+    // Set sprite texture và origin
+    sprite.setTexture(*sheet.texture);
+    sprite.setOrigin(sheet.frameWidth / 2.0f, sheet.frameHeight / 2.0f);
     
-    // Sau đó set shape position để đồng bộ
-    shape.setPosition(x, y);
+    // QUAN TRỌNG: Scale sprite để phù hợp với game window (a prescaled atlas block is about 1:1)
+    sprite.setScale(sheet.scale);
     
-    // Debug: kiểm tra position sync
     #if ANIMATION_DEBUG_MODE
-    static sf::Vector2f lastPos(-1, -1);
-    if (lastPos.x != x || lastPos.y != y) {
-        std::cout << "Enemy position set: (" << x << ", " << y 
-                  << ") - Sprite: (" << sprite.getPosition().x << ", " << sprite.getPosition().y
-                  << ") - Shape: (" << shape.getPosition().x << ", " << shape.getPosition().y << ")" << std::endl;
-        lastPos = sf::Vector2f(x, y);
-    }
+    std::cout << "Enemy animation setup: " << sheet.frameWidth << "x" << sheet.frameHeight 
+              << " scale: " << sheet.scale.x << "x" << sheet.scale.y << std::endl;
     #endif
 }
-
-void Enemy::setupEnemyAnimation(const std::string& spritesheetPath, int frameWidth, int frameHeight, int frameCount) {
-    if (loadTexture(spritesheetPath)) {
-        try {
-            // Tạo animation với texture đã load
-            Animation* anim = new Animation(&texture, frameWidth, frameHeight, frameCount, ENEMY_FRAME_DURATION, ANIMATION_ENABLE_LOOP);
-            setAnimation(anim);
-            enableAnimation(true);
-            
-            // Set sprite texture và origin
-            sprite.setTexture(texture);
-            sprite.setOrigin(frameWidth / 2.0f, frameHeight / 2.0f);
-            
-            // QUAN TRỌNG: Scale sprite để phù hợp với game window
-            sprite.setScale(ENEMY_ANIMATION_SCALE_X, ENEMY_ANIMATION_SCALE_Y);
-            
-            // Set texture quality settings
-            if (currentAnimation) {
-                currentAnimation->setSmooth(ANIMATION_SMOOTH_TEXTURE);
-                currentAnimation->setRepeated(ANIMATION_REPEATED_TEXTURE);
-            }
-            
-            // Update shape position để đồng bộ với sprite
-            shape.setPosition(sprite.getPosition());
-            
-                    #if ANIMATION_DEBUG_MODE
-        std::cout << "Enemy animation setup: " << frameWidth << "x" << frameHeight 
-                  << " frames: " << frameCount << " scale: " << ENEMY_ANIMATION_SCALE_X 
-                  << "x" << ENEMY_ANIMATION_SCALE_Y << std::endl;
-        std::cout << "Enemy texture loaded: " << spritesheetPath << std::endl;
-        std::cout << "Enemy sprite texture: " << (sprite.getTexture() ? "OK" : "NULL") << std::endl;
-        std::cout << "Enemy animation: ENABLED" << std::endl;
-        std::cout << "Enemy sprite scale: " << sprite.getScale().x << "x" << sprite.getScale().y << std::endl;
-        std::cout << "Enemy animation object: " << (currentAnimation ? "OK" : "NULL") << std::endl;
-        std::cout << "Enemy frames count: " << (currentAnimation ? currentAnimation->getFrameCount() : 0) << std::endl;
-        #endif
-        } catch (...) {
-            // Nếu có lỗi, disable animation và log
-            enableAnimation(false);
-            #if ANIMATION_DEBUG_MODE
-            std::cout << "ERROR: Failed to setup enemy animation, disabling animation" << std::endl;
-            #endif
-        }
-    } else {
-        #if ANIMATION_DEBUG_MODE
-        std::cout << "ERROR: Failed to load enemy texture: " << spritesheetPath << std::endl;
-        #endif
-    }
-}
@@ -0,0 +1,189 @@
+#include "../include/EnemyArchetype.h"
+#include "../include/AnimationConfig.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// Static member definitions
+EnemyArchetype EnemyArchetypes::archetypes[MAX_ARCHETYPES];
+SpriteClip EnemyArchetypes::clips[MAX_CLIPS];
+int EnemyArchetypes::archetypeCount = 0;
+int EnemyArchetypes::clipCount = 0;
+int EnemyArchetypes::totalSpawnWeight = 0;
+float EnemyArchetypes::maxHitRadius = 0.f;
+
+void EnemyArchetypes::loadDefaults() {
+    clips[0] = {0, 0, ENEMY_SHEET.frameWidth, ENEMY_SHEET.frameHeight, ENEMY_SHEET.frameCount};
+    clipCount = 1;
+
+    EnemyArchetype& grunt = archetypes[0];
+    grunt.speed = 80.f;
+    grunt.detectionRange = 500.f;
+    grunt.attackRange = 20.f;
+    grunt.maxHp = 50;
+    grunt.damage = 15;
+    grunt.hitboxWidth = 28;
+    grunt.hitboxHeight = 28;
+    grunt.hitRadius = 14.f;
+    grunt.spriteClip = 0;
+    grunt.behaviour = EnemyBehaviour::CHASE;
+    grunt.tint = 0xFFFFFFFF;
+    grunt.spawnWeight = 1;
+    std::strcpy(grunt.name, "grunt");
+    archetypeCount = 1;
+    totalSpawnWeight = 1;
+    maxHitRadius = grunt.hitRadius;
+}
+
+bool EnemyArchetypes::parseBehaviour(const std::string& text, EnemyBehaviour& behaviour) {
+    if (text == "chase") behaviour = EnemyBehaviour::CHASE;
+    else if (text == "charge") behaviour = EnemyBehaviour::CHARGE;
+    else if (text == "ambush") behaviour = EnemyBehaviour::AMBUSH;
+    else if (text == "coward") behaviour = EnemyBehaviour::COWARD;
+    else return false;
+    return true;
+}
+
+bool EnemyArchetypes::parseTint(const std::string& text, std::uint32_t& tint) {
+    // Exactly RRGGBBAA: std::stoul would throw on non-hex text and accept a sign or "0x"
+    if (text.size() != 8) return false;
+    std::uint32_t value = 0;
+    for (char c : text) {
+        int digit;
+        if (c >= '0' && c <= '9') digit = c - '0';
+        else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+        else return false;
+        value = (value << 4) | static_cast<std::uint32_t>(digit);
+    }
+    tint = value;
+    return true;
+}
+
+bool EnemyArchetypes::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        loadDefaults();
+        std::cerr << "Warning: Could not open " << path << ", using the default enemy type" << std::endl;
+        return false;
+    }
+    return parse(file, path);
+}
+
+bool EnemyArchetypes::loadFromMemory(const unsigned char* data, std::size_t size) {
+    std::istringstream input(std::string(reinterpret_cast<const char*>(data), size));
+    return parse(input, "packed enemy types");
+}
+
+bool EnemyArchetypes::parse(std::istream& input, const std::string& source) {
+    loadDefaults();
+
+    // Parse into a staging table so a bad file leaves the defaults untouched
+    EnemyArchetype loaded[MAX_ARCHETYPES];
+    SpriteClip loadedClips[MAX_CLIPS];
+    int loadedCount = 0;
+    int loadedClipCount = 1;
+    for (SpriteClip& clip : loadedClips) {
+        clip = clips[0]; // undefined ids fall back to the whole default sheet
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(input, line)) {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+
+        std::istringstream fields(line);
+        std::string kind;
+        if (!(fields >> kind)) continue;
+
+        bool ok = false;
+        if (kind == "clip") {
+            int id, x, y, width, height, frames;
+            // Clips index ENEMY_FRAMES, so they must be whole frames of the enemy sheet's grid
+            ok = (fields >> id >> x >> y >> width >> height >> frames) && id >= 0 && id < MAX_CLIPS &&
+                 width == ENEMY_SHEET.frameWidth && height == ENEMY_SHEET.frameHeight && x >= 0 && y >= 0 &&
+                 x % width == 0 && y % height == 0 && frames > 0 && frames <= 255;
+            if (ok) {
+                loadedClips[id] = {static_cast<std::int16_t>(x), static_cast<std::int16_t>(y),
+                                   static_cast<std::int16_t>(width), static_cast<std::int16_t>(height),
+                                   static_cast<std::uint8_t>(frames)};
+                if (id >= loadedClipCount) loadedClipCount = id + 1;
+            }
+        } else if (kind == "enemy" && loadedCount < MAX_ARCHETYPES) {
+            std::string name, behaviourText, tintText;
+            int hp, damage, hitWidth, hitHeight, clip, weight;
+            float speed, detect, attack;
+            EnemyArchetype& type = loaded[loadedCount];
+            ok = (fields >> name >> behaviourText >> hp >> damage >> speed >> detect >> attack >> hitWidth >> hitHeight >>
+                  clip >> tintText >> weight) &&
+                 parseBehaviour(behaviourText, type.behaviour) && name.size() < sizeof(type.name) && hp > 0 &&
+                 hp <= 32767 && damage >= 0 && damage <= 32767 && hitWidth > 0 && hitWidth <= 255 && hitHeight > 0 &&
+                 hitHeight <= 255 && clip >= 0 && clip < MAX_CLIPS && weight >= 0 && weight <= 255 && parseTint(tintText, type.tint);
+            if (ok) {
+                type.speed = speed;
+                type.detectionRange = detect;
+                type.attackRange = attack;
+                type.maxHp = static_cast<std::int16_t>(hp);
+                type.damage = static_cast<std::int16_t>(damage);
+                type.hitboxWidth = static_cast<std::uint8_t>(hitWidth);
+                type.hitboxHeight = static_cast<std::uint8_t>(hitHeight);
+                type.hitRadius = std::max(hitWidth, hitHeight) * 0.5f;
+                type.spriteClip = static_cast<std::uint8_t>(clip);
+                type.spawnWeight = static_cast<std::uint8_t>(weight);
+                std::strcpy(type.name, name.c_str());
+                loadedCount++;
+            }
+        }
+
+        if (!ok) {
+            std::cerr << "Warning: " << source << ":" << lineNumber << ": invalid entry ignored" << std::endl;
+        }
+    }
+
+    if (loadedCount == 0) {
+        std::cerr << "Warning: no enemy types in " << source << ", using the default enemy type" << std::endl;
+        return false;
+    }
+
+    // Commit
+    int weights = 0;
+    maxHitRadius = 0.f;
+    for (int i = 0; i < loadedCount; i++) {
+        maxHitRadius = std::max(maxHitRadius, loaded[i].hitRadius);
+        if (loaded[i].spriteClip >= loadedClipCount) loaded[i].spriteClip = 0;
+        archetypes[i] = loaded[i];
+        weights += loaded[i].spawnWeight;
+    }
+    for (int i = 0; i < loadedClipCount; i++) {
+        clips[i] = loadedClips[i];
+    }
+    archetypeCount = loadedCount;
+    clipCount = loadedClipCount;
+    totalSpawnWeight = weights;
+
+    #if ANIMATION_DEBUG_MODE
+    std::cout << "Loaded " << archetypeCount << " enemy types and " << clipCount << " sprite clips from " << source << std::endl;
+    #endif
+    return true;
+}
+
+int EnemyArchetypes::find(const std::string& name) {
+    for (int i = 0; i < archetypeCount; i++) {
+        if (name == archetypes[i].name) return i;
+    }
+    return -1;
+}
+
+int EnemyArchetypes::pickRandom(unsigned int roll) {
+    if (totalSpawnWeight <= 0) return 0;
+    int pick = static_cast<int>(roll % static_cast<unsigned int>(totalSpawnWeight));
+    for (int i = 0; i < archetypeCount; i++) {
+        pick -= archetypes[i].spawnWeight;
+        if (pick < 0) return i;
+    }
+    return 0;
+}
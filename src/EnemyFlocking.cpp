@@ -0,0 +1,135 @@
+#include "../include/EnemyFlocking.h"
+#include "../include/Map.h"
+#include <cmath>
+
+EnemyFlocking::EnemyFlocking(const FlockingSettings& settings)
+    : settings(settings), grid(settings.neighbourRadius * 2.f, 64) {
+}
+
+void EnemyFlocking::reserve(int maxEnemies) {
+    grid.reserve(maxEnemies);
+    posX.reserve(maxEnemies);
+    posY.reserve(maxEnemies);
+    neighbours.reserve(static_cast<size_t>(maxEnemies) * MAX_NEIGHBOURS);
+    steerX.reserve(maxEnemies);
+    steerY.reserve(maxEnemies);
+}
+
+void EnemyFlocking::compute(const sf::Vector2f* positions, int count, const Map* map) {
+    posX.resize(count);
+    posY.resize(count);
+    steerX.assign(count, 0.f);
+    steerY.assign(count, 0.f);
+    if (count <= 0) return;
+
+    for (int i = 0; i < count; i++) {
+        posX[i] = positions[i].x;
+        posY[i] = positions[i].y;
+    }
+
+    gatherNeighbours(positions, count);
+    accumulateSteering(count);
+    if (map) {
+        addObstacleRepulsion(count, map);
+    }
+}
+
+void EnemyFlocking::gatherNeighbours(const sf::Vector2f* positions, int count) {
+    grid.rebuild(positions, count);
+    neighbours.resize(static_cast<size_t>(count) * MAX_NEIGHBOURS);
+
+    for (int i = 0; i < count; i++) {
+        int* slots = &neighbours[static_cast<size_t>(i) * MAX_NEIGHBOURS];
+        float slotDistSq[MAX_NEIGHBOURS];
+        int found = 0;
+        for (int k = 0; k < MAX_NEIGHBOURS; k++) {
+            slots[k] = i; // empty slot = self, zero contribution
+        }
+
+        // Keep the K nearest, sorted by distance (insertion into a tiny array)
+        grid.queryRadius(positions[i], settings.neighbourRadius, [&](int other) {
+            if (other == i) return;
+            float dx = posX[other] - posX[i];
+            float dy = posY[other] - posY[i];
+            float distSq = dx * dx + dy * dy;
+            if (found == MAX_NEIGHBOURS && distSq >= slotDistSq[MAX_NEIGHBOURS - 1]) return;
+
+            int k = found < MAX_NEIGHBOURS ? found++ : MAX_NEIGHBOURS - 1;
+            while (k > 0 && slotDistSq[k - 1] > distSq) {
+                slots[k] = slots[k - 1];
+                slotDistSq[k] = slotDistSq[k - 1];
+                k--;
+            }
+            slots[k] = other;
+            slotDistSq[k] = distSq;
+        });
+    }
+}
+
+void EnemyFlocking::accumulateSteering(int count) {
+    const float radiusSq = settings.neighbourRadius * settings.neighbourRadius;
+    const float inverseRadius = 1.f / settings.neighbourRadius;
+    const float* x = posX.data();
+    const float* y = posY.data();
+    const int* slots = neighbours.data();
+
+    for (int i = 0; i < count; i++) {
+        float sepX = 0.f, sepY = 0.f;
+        float sumX = 0.f, sumY = 0.f;
+        float used = 0.f;
+
+        // Fixed trip count and no branches: self slots have dx = dy = 0
+        for (int k = 0; k < MAX_NEIGHBOURS; k++) {
+            int other = slots[i * MAX_NEIGHBOURS + k];
+            float dx = x[other] - x[i];
+            float dy = y[other] - y[i];
+            float distSq = dx * dx + dy * dy;
+            float active = (distSq > 0.f && distSq <= radiusSq) ? 1.f : 0.f;
+
+            // Separation: stronger the closer the neighbour, 0 at the radius
+            float push = active * (1.f - std::sqrt(distSq) * inverseRadius) / (distSq + 1.f);
+            sepX -= dx * push;
+            sepY -= dy * push;
+
+            sumX += dx * active;
+            sumY += dy * active;
+            used += active;
+        }
+
+        // Cohesion: towards the neighbours' centre (offsets are already relative)
+        float inverseUsed = used > 0.f ? 1.f / used : 0.f;
+        steerX[i] = sepX * settings.separationWeight * settings.neighbourRadius +
+                    sumX * inverseUsed * inverseRadius * settings.cohesionWeight;
+        steerY[i] = sepY * settings.separationWeight * settings.neighbourRadius +
+                    sumY * inverseUsed * inverseRadius * settings.cohesionWeight;
+    }
+
+    // Two enemies on exactly the same spot: separation is zero, nudge them apart by index
+    for (int i = 0; i < count; i++) {
+        int other = slots[i * MAX_NEIGHBOURS];
+        if (other != i && x[other] == x[i] && y[other] == y[i]) {
+            float angle = static_cast<float>(i) * 2.399963f; // golden angle
+            steerX[i] += std::cos(angle) * settings.separationWeight;
+            steerY[i] += std::sin(angle) * settings.separationWeight;
+        }
+    }
+}
+
+void EnemyFlocking::addObstacleRepulsion(int count, const Map* map) {
+    // Four probes per enemy; each blocked one pushes the other way
+    const float probe = settings.obstacleProbe;
+    for (int i = 0; i < count; i++) {
+        float pushX = 0.f, pushY = 0.f;
+        if (!map->isPassable(posX[i] + probe, posY[i])) pushX -= 1.f;
+        if (!map->isPassable(posX[i] - probe, posY[i])) pushX += 1.f;
+        if (!map->isPassable(posX[i], posY[i] + probe)) pushY -= 1.f;
+        if (!map->isPassable(posX[i], posY[i] - probe)) pushY += 1.f;
+        steerX[i] += pushX * settings.obstacleWeight;
+        steerY[i] += pushY * settings.obstacleWeight;
+    }
+}
+
+std::size_t EnemyFlocking::getMemoryBytes() const {
+    return grid.getMemoryBytes() + (posX.capacity() + posY.capacity() + steerX.capacity() + steerY.capacity()) * sizeof(float) +
+           neighbours.capacity() * sizeof(int);
+}
@@ -0,0 +1,109 @@
+#include "../include/FrameArena.h"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+
+// Static member definitions
+std::vector<unsigned char> FrameArena::buffer;
+std::size_t FrameArena::offset = 0;
+std::size_t FrameArena::highWaterMark = 0;
+std::size_t FrameArena::overflowBytes = 0;
+std::size_t FrameArena::requestedGrowth = 0;
+std::vector<char*> FrameArena::overflowStrings;
+FrameArenaResource FrameArena::resource;
+
+void* FrameArenaResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+    return FrameArena::allocate(bytes, alignment);
+}
+
+void FrameArenaResource::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+    FrameArena::deallocate(p, bytes, alignment);
+}
+
+bool FrameArenaResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+void FrameArena::initialize(std::size_t capacityBytes) {
+    buffer.assign(capacityBytes, 0);
+    offset = 0;
+    highWaterMark = 0;
+    overflowBytes = 0;
+    requestedGrowth = 0;
+}
+
+void FrameArena::reset() {
+    // Grow between frames (never during one) if the last frame overflowed,
+    // so a steady-state frame always fits in the arena
+    if (requestedGrowth > buffer.size()) {
+        std::cout << "FrameArena: growing from " << buffer.size() << " to " << requestedGrowth
+                  << " bytes (" << overflowBytes << " bytes overflowed)" << std::endl;
+        buffer.assign(requestedGrowth, 0);
+    }
+    for (char* text : overflowStrings) {
+        delete[] text;
+    }
+    overflowStrings.clear();
+
+    requestedGrowth = 0;
+    overflowBytes = 0;
+    offset = 0;
+}
+
+void* FrameArena::allocate(std::size_t bytes, std::size_t alignment) {
+    std::uintptr_t base = reinterpret_cast<std::uintptr_t>(buffer.data());
+    std::uintptr_t current = base + offset;
+    std::uintptr_t aligned = (current + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    std::size_t newOffset = static_cast<std::size_t>(aligned - base) + bytes;
+
+    if (!buffer.empty() && newOffset <= buffer.size()) {
+        offset = newOffset;
+        highWaterMark = std::max(highWaterMark, offset);
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    // Arena exhausted: serve from the heap and ask for a bigger arena next frame
+    overflowBytes += bytes;
+    requestedGrowth = std::max(requestedGrowth, (std::max(buffer.size(), offset + overflowBytes)) * 2);
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void FrameArena::deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+    // Arena memory is released in bulk by reset(); only heap overflow is freed here
+    if (!owns(p)) {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+}
+
+bool FrameArena::owns(const void* p) {
+    const unsigned char* bytePtr = static_cast<const unsigned char*>(p);
+    return !buffer.empty() && bytePtr >= buffer.data() && bytePtr < buffer.data() + buffer.size();
+}
+
+const char* FrameArena::format(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    va_list argsCopy;
+    va_copy(argsCopy, args);
+    int length = std::vsnprintf(nullptr, 0, fmt, args);
+    va_end(args);
+
+    if (length < 0) {
+        va_end(argsCopy);
+        return "";
+    }
+
+    std::size_t size = static_cast<std::size_t>(length) + 1;
+    char* text = static_cast<char*>(allocate(size, alignof(char)));
+    if (!owns(text)) {
+        // Nobody deallocates formatted strings, so keep heap spills until reset()
+        deallocate(text, size, alignof(char));
+        text = new char[size];
+        overflowStrings.push_back(text);
+    }
+    std::vsnprintf(text, size, fmt, argsCopy);
+    va_end(argsCopy);
+    return text;
+}
@@ -1,5 +1,10 @@
 #include "../include/Game.h"
 #include "../include/AnimationConfig.h"
+#include "../include/FrameArena.h"
+#include "../include/AllocationCounter.h"
+#include "../include/SpriteAtlas.h"
+#include "../include/MemoryBudget.h"
+#include "../include/AssetPaths.h"
 #include <iostream>
 #include <fstream>
 #include <algorithm>
@@ -9,8 +14,12 @@
 
 
 
-Game::Game() : window(sf::VideoMode(800, 600), "Soul Knight") {
-    state = GameState::MAIN_MENU;
+Game::Game() : window(sf::VideoMode(800, 600), "Soul Knight"), gameTexturesHeld(false), menuBackgroundAsset(0),
+      menuBackgroundHeld(false), playerSpritesheetAsset(0), enemySpritesheetAsset(0),
+      wallTextureAsset(0), floorTextureAsset(0), atlasAsset(0), selectedHero(0), minimap(640.f, 10.f),
+      enemyTierTick(0), aiTick(0), aiDecisionCursor(0),
+      gameStartTick(0), enemySpawnTimer(0), enemySpawnDue(false), frameWorkMicroseconds(0), lateInputSampling(true),
+      windowFocused(true) {
     selectedOption = 0;
     gameInProgress = false;
     playerName = "";
@@ -25,8 +34,43 @@ Game::Game() : window(sf::VideoMode(800, 600), "Soul Knight") {
     // Seed random number generator
     srand(static_cast<unsigned>(time(nullptr)));
 
-    // Window settings
-    window.setFramerateLimit(60);
+    // Per-frame scratch memory (reset at the top of every frame in run())
+    FrameArena::initialize();
+
+    // No enemy sprites until the game textures are loaded
+    enemyFrames = SpriteFrames::wholeSheet(nullptr, ENEMY_SHEET.frameWidth, ENEMY_SHEET.frameHeight, ENEMY_SHEET.frameCount,
+                                           sf::Vector2f(ENEMY_SHEET.scaleX, ENEMY_SHEET.scaleY));
+
+    // One mapped file for every asset, if the pack was built; every path is relative to
+    // the asset root (next to the executable), not the working directory
+    assets.openPack(AssetPaths::resolve(ASSET_PACK_PATH));
+
+    // Enemy types (stats, sprite clip, behaviour) - must be loaded before any Enemy exists
+    const unsigned char* typesData = nullptr;
+    std::size_t typesSize = 0;
+    if (assets.getFileData(ENEMY_TYPES_PATH, typesData, typesSize)) {
+        EnemyArchetypes::loadFromMemory(typesData, typesSize);
+    } else {
+        EnemyArchetypes::load(AssetPaths::resolve(ENEMY_TYPES_PATH));
+    }
+
+    // Kiosks set a ceiling for texture and sound memory; assets nothing retains are
+    // evicted to stay under it
+    if (const char* budgetMegabytes = std::getenv(MEMORY_BUDGET_VARIABLE)) {
+        MemoryBudget::setBudget(static_cast<std::size_t>(std::strtoul(budgetMegabytes, nullptr, 10)) * 1024 * 1024);
+        std::cout << "Memory budget: " << MemoryBudget::getBudget() / (1024 * 1024) << " MB" << std::endl;
+    }
+
+    // The game textures decode (or, pre-decoded in the pack, just upload) while the menus are up
+    requestGameAssets();
+    sounds.load(assets);
+    enemies.reserve(MAX_ACTIVE_ENEMIES);
+    activeEnemyPositions.reserve(MAX_ACTIVE_ENEMIES);
+    activeEnemyKeep.reserve(MAX_ACTIVE_ENEMIES);
+    activeEnemyGrid.reserve(MAX_ACTIVE_ENEMIES);
+    enemyFlocking.reserve(MAX_ACTIVE_ENEMIES);
+
+    // Window settings (the frame rate is paced in run())
     window.setKeyRepeatEnabled(false); // Prevent key repeat for better control
 
     loadFont();
@@ -39,6 +83,11 @@ Game::Game() : window(sf::VideoMode(800, 600), "Soul Knight") {
     // Initialize View system
     View::initialize(&window, &font, camera.get());
 
+    // Screens: one Scene per GameState, main menu first
+    sceneStack.initialize(&window);
+    createScenes();
+    sceneStack.reset(getScene(GameState::MAIN_MENU));
+
 
 
     // setup main menu - title now handled by View system
@@ -62,160 +111,276 @@ Game::Game() : window(sf::VideoMode(800, 600), "Soul Knight") {
 
     // UI texts are now handled by View system - no need for setup
 
-    // Load menu background after everything is initialized
-    View::loadMenuBackground("assets/background_menu.png");
+    // Load menu background after everything is initialized (the first frame needs it)
+    menuBackgroundAsset = assets.loadTextureNow(MENU_BACKGROUND_PATH);
+    holdMenuBackground();
 }
 
 void Game::loadFont() {
-    // Try to load font from multiple sources
-    if (!font.loadFromFile("assets/arial.TTF")) {
+    // Try to load font from multiple sources: the asset pack first (the font reads
+    // from the mapping, which the loader keeps alive), then loose files
+    const unsigned char* fontData = nullptr;
+    std::size_t fontSize = 0;
+    if (assets.getFileData(FONT_PATH, fontData, fontSize) && font.loadFromMemory(fontData, fontSize)) {
+        return;
+    }
+    if (!font.loadFromFile(AssetPaths::resolve(FONT_PATH))) {
         if (!font.loadFromFile("C:/Windows/Fonts/arial.ttf")) {
             std::cerr << "Warning: Could not load font. Text may not display properly.\n";
         }
     }
 }
 
+Game::~Game() {
+    SimClock::getTimers().cancel(enemySpawnTimer);
+    MemoryBudget::report(std::cout);
+}
+
+void Game::onTimer(int eventId) {
+    if (eventId == EVENT_SPAWN_ENEMY) {
+        enemySpawnTimer = 0;
+        enemySpawnDue = true; // spawnEnemies() acts on it once there is room
+    }
+}
+
 void Game::run() {
     while (window.isOpen()) {
-        Input::update(); // Update input state first
-        processEvents(); // Only text input and window events
-        handleMenuInput(); // Handle menu navigation
-        handleCharacterSelection(); // Handle character selection
-        handleSettings(); // Handle settings input
-        handleLeaderboard(); // Handle leaderboard input
-        handleGameInput(); // Handle game input
-        update();
+        sf::Time frameSlot = lastPresentTime +
+                             sf::microseconds(windowFocused ? TARGET_FRAME_MICROSECONDS : UNFOCUSED_FRAME_MICROSECONDS);
+
+        // Late sampling: idle first, so input is read as close to the present as the frame's work allows
+        if (lateInputSampling) {
+            waitForFrameSlot(frameSlot - sf::microseconds(frameWorkMicroseconds + LATE_INPUT_MARGIN_MICROSECONDS));
+        }
+
+        // Nothing to redraw (a static menu, a minimised window): sleep until something happens
+        waitWhileIdle();
+        if (!window.isOpen()) break;
+
+        sf::Time sampleTime = frameClock.getElapsedTime();
+        FrameArena::reset(); // Release last frame's transient allocations
+        processEvents(); // Drains the window's events into Input
+        Input::update(); // Then snapshot this frame's key and mouse state
+        handleDebugInput();
+        sceneStack.applyChanges();
+        assets.update(); // Uploads textures that finished decoding
+        updateMenuBackground();
+        sceneStack.update(); // Only the top scene handles input and runs
         render();
+
+        // Early sampling: the finished frame waits for its slot
+        if (!lateInputSampling) {
+            waitForFrameSlot(frameSlot);
+        }
+        View::display();
+
+        // Timing: work estimate for late sampling, and input -> present latency
+        sf::Time presentTime = frameClock.getElapsedTime();
+        sf::Int64 work = (presentTime - sampleTime).asMicroseconds();
+        frameWorkMicroseconds += (work - frameWorkMicroseconds) / 8;
+        perfOverlay.recordFrame(presentTime - lastPresentTime, presentTime - sampleTime);
+        sf::Time inputTime;
+        if (Input::getSampledInputTime(inputTime)) {
+            perfOverlay.recordLatency(presentTime - inputTime);
+        }
+        lastPresentTime = presentTime;
+    }
+}
+
+void Game::waitForFrameSlot(sf::Time deadline) {
+    // Short sleeps rather than one long one: events are drained (and timestamped)
+    // as they arrive instead of when the next frame starts
+    while (window.isOpen()) {
+        sf::Time remaining = deadline - frameClock.getElapsedTime();
+        if (remaining <= sf::Time::Zero) break;
+        sf::sleep(remaining < sf::milliseconds(1) ? remaining : sf::milliseconds(1));
+        processEvents();
+    }
+}
+
+void Game::waitWhileIdle() {
+    while (window.isOpen() && isIdle()) {
+        if (isMinimised()) {
+            // Few wakeups while hidden; the screen is stale once it comes back
+            sf::sleep(sf::milliseconds(MINIMISED_SLEEP_MS));
+            processEvents();
+            if (!isMinimised()) {
+                sceneStack.invalidate();
+            }
+        } else {
+            // Static menu: block in the OS until the next event
+            sf::Event event;
+            if (window.waitEvent(event)) {
+                handleWindowEvent(event);
+            }
+        }
+    }
+}
+
+bool Game::isIdle() const {
+    // Assets still loading need update() to pick them up, so a static menu keeps ticking until they land
+    return isMinimised() || (sceneStack.isIdle() && !perfOverlay.isVisible() && assets.getPendingCount() == 0);
+}
+
+bool Game::isMinimised() const {
+    // A minimised window has an empty client area on Windows; elsewhere it
+    // loses focus, which pauses the game into a static (idle) menu anyway
+    sf::Vector2u size = window.getSize();
+    return size.x == 0 || size.y == 0;
+}
+
+void Game::handleDebugInput() {
+    if (Input::isPerfOverlayTogglePressed()) {
+        perfOverlay.toggle();
+    }
+    if (Input::isInputSamplingTogglePressed()) {
+        lateInputSampling = !lateInputSampling;
+        perfOverlay.resetLatency(); // the histogram describes one mode at a time
+        std::cout << "Input sampling: " << (lateInputSampling ? "late" : "early") << std::endl;
     }
 }
 
 void Game::processEvents() {
     sf::Event event;
     while (window.pollEvent(event)) {
-        if (event.type == sf::Event::Closed)
-            window.close();
+        handleWindowEvent(event);
+    }
+}
 
-        // Only handle event-based input (text input, window events)
-        if (state == GameState::NAME_INPUT) {
-            if (Input::handleTextInput(event, playerName, 20)) {
-                // Text was modified or Enter was pressed
-                if (event.text.unicode == '\r' || event.text.unicode == '\n') {
-                    // Enter pressed
-                    if (!playerName.empty()) {
-                        state = GameState::CHARACTER_SELECT;
-                    }
-                } else {
-                    // Text was modified - no need to update sf::Text, View system handles it
-                }
-            }
-            else if (event.type == sf::Event::KeyPressed) {
-                if (event.key.code == sf::Keyboard::Escape) {
-                    state = GameState::MAIN_MENU;
-                }
-            }
+void Game::handleWindowEvent(const sf::Event& event) {
+    if (event.type == sf::Event::Closed)
+        window.close();
+
+    // Losing focus pauses the game and drops to the unfocused frame rate
+    if (event.type == sf::Event::LostFocus) {
+        windowFocused = false;
+        Scene* scene = sceneStack.top();
+        if (scene && scene->getId() == GameState::IN_GAME && !sceneStack.hasPendingChanges()) {
+            sceneStack.push(getScene(GameState::PAUSED_MENU));
         }
+    } else if (event.type == sf::Event::GainedFocus) {
+        windowFocused = true;
+    }
+
+    Input::handleEvent(event, frameClock.getElapsedTime());
 
-        // All other input handling moved to Input system methods
-        // IN_GAME state doesn't need event handling - uses Input system in main loop
+    // Event-based input (text entry) goes to the top scene; everything else uses the Input system
+    sceneStack.handleEvent(event);
+}
+
+void Game::handleNameInputEvent(const sf::Event& event) {
+    if (Input::handleTextInput(event, playerName, 20)) {
+        // Text was modified or Enter was pressed
+        if (event.text.unicode == '\r' || event.text.unicode == '\n') {
+            // Enter pressed
+            if (!playerName.empty()) {
+                sceneStack.pop();
+                sceneStack.push(getScene(GameState::CHARACTER_SELECT));
+            }
+        } else {
+            // Text was modified - no need to update sf::Text, View system handles it
+        }
+    }
+    else if (event.type == sf::Event::KeyPressed) {
+        if (event.key.code == sf::Keyboard::Escape) {
+            sceneStack.reset(getScene(GameState::MAIN_MENU));
+        }
     }
 }
 
-void Game::handleMenuInput() {
+void Game::handleMainMenuInput() {
     // Handle menu navigation using Input system (not event-based)
-    if (state == GameState::MAIN_MENU) {
-        if (Input::isMenuUpPressed()) {
-            selectedOption = (selectedOption - 1 + menuOptions.size()) % menuOptions.size();
-            std::cout << "Selected option: " << selectedOption << std::endl;
-        } else if (Input::isMenuDownPressed()) {
-            selectedOption = (selectedOption + 1) % menuOptions.size();
-            std::cout << "Selected option: " << selectedOption << std::endl;
-        } else if (Input::isMenuSelectPressed()) {
-            std::cout << "Enter pressed, selected option: " << selectedOption << std::endl;
-
-            if (selectedOption == 0) {
-                // New Game - chuyển đến name input
-                std::cout << "New Game selected, going to name input..." << std::endl;
-                gameInProgress = false; // Reset game state
-                playerName = ""; // Reset player name
-                state = GameState::NAME_INPUT;
-            }
-            else if (selectedOption == 1) {
-                std::cout << "Leaderboard selected" << std::endl;
-                state = GameState::LEADERBOARD;
-            }
-            else if (selectedOption == 2) {
-                std::cout << "Settings selected" << std::endl;
-                state = GameState::SETTINGS;
-            }
-            else if (selectedOption == 3) {
-                std::cout << "Exit selected" << std::endl;
-                window.close();
-            }
+    if (Input::isMenuUpPressed()) {
+        selectedOption = (selectedOption - 1 + menuOptions.size()) % menuOptions.size();
+        std::cout << "Selected option: " << selectedOption << std::endl;
+    } else if (Input::isMenuDownPressed()) {
+        selectedOption = (selectedOption + 1) % menuOptions.size();
+        std::cout << "Selected option: " << selectedOption << std::endl;
+    } else if (Input::isMenuSelectPressed()) {
+        std::cout << "Enter pressed, selected option: " << selectedOption << std::endl;
+
+        if (selectedOption == 0) {
+            // New Game - chuyển đến name input
+            std::cout << "New Game selected, going to name input..." << std::endl;
+            gameInProgress = false; // Reset game state
+            playerName = ""; // Reset player name
+            sceneStack.push(getScene(GameState::NAME_INPUT));
+        }
+        else if (selectedOption == 1) {
+            std::cout << "Leaderboard selected" << std::endl;
+            sceneStack.push(getScene(GameState::LEADERBOARD));
+        }
+        else if (selectedOption == 2) {
+            std::cout << "Settings selected" << std::endl;
+            sceneStack.push(getScene(GameState::SETTINGS));
+        }
+        else if (selectedOption == 3) {
+            std::cout << "Exit selected" << std::endl;
+            window.close();
         }
     }
-    else if (state == GameState::PAUSED_MENU) {
-        if (Input::isMenuUpPressed()) {
-            selectedOption = (selectedOption - 1 + pausedMenuOptions.size()) % pausedMenuOptions.size();
-            std::cout << "Selected option: " << selectedOption << std::endl;
-        } else if (Input::isMenuDownPressed()) {
-            selectedOption = (selectedOption + 1) % pausedMenuOptions.size();
-            std::cout << "Selected option: " << selectedOption << std::endl;
-        } else if (Input::isMenuSelectPressed()) {
-            std::cout << "Enter pressed, selected option: " << selectedOption << std::endl;
-
-            if (selectedOption == 0) {
-                // Continue Game
-                std::cout << "Continue Game selected" << std::endl;
-                continueGame();
-            }
-            else if (selectedOption == 1) {
-                // New Game - reset và chuyển đến name input
-                gameInProgress = false;
-                playerName = ""; // Reset player name
-                state = GameState::NAME_INPUT;
-            }
-            else if (selectedOption == 2) {
-                std::cout << "Leaderboard selected" << std::endl;
-                state = GameState::LEADERBOARD;
-            }
-            else if (selectedOption == 3) {
-                std::cout << "Settings selected" << std::endl;
-                state = GameState::SETTINGS;
-            }
-            else if (selectedOption == 4) {
-                std::cout << "Exit selected" << std::endl;
-                window.close();
-            }
-        } else if (Input::isPausePressed()) {
-            // Quick resume with P key
+}
+
+void Game::handlePausedMenuInput() {
+    if (Input::isMenuUpPressed()) {
+        selectedOption = (selectedOption - 1 + pausedMenuOptions.size()) % pausedMenuOptions.size();
+        std::cout << "Selected option: " << selectedOption << std::endl;
+    } else if (Input::isMenuDownPressed()) {
+        selectedOption = (selectedOption + 1) % pausedMenuOptions.size();
+        std::cout << "Selected option: " << selectedOption << std::endl;
+    } else if (Input::isMenuSelectPressed()) {
+        std::cout << "Enter pressed, selected option: " << selectedOption << std::endl;
+
+        if (selectedOption == 0) {
+            // Continue Game
+            std::cout << "Continue Game selected" << std::endl;
             continueGame();
         }
+        else if (selectedOption == 1) {
+            // New Game - reset và chuyển đến name input
+            gameInProgress = false;
+            playerName = ""; // Reset player name
+            sceneStack.reset(getScene(GameState::MAIN_MENU));
+            sceneStack.push(getScene(GameState::NAME_INPUT));
+        }
+        else if (selectedOption == 2) {
+            std::cout << "Leaderboard selected" << std::endl;
+            sceneStack.push(getScene(GameState::LEADERBOARD));
+        }
+        else if (selectedOption == 3) {
+            std::cout << "Settings selected" << std::endl;
+            sceneStack.push(getScene(GameState::SETTINGS));
+        }
+        else if (selectedOption == 4) {
+            std::cout << "Exit selected" << std::endl;
+            window.close();
+        }
+    } else if (Input::isPausePressed()) {
+        // Quick resume with P key
+        continueGame();
     }
 }
 
 void Game::handleCharacterSelection() {
-    if (state != GameState::CHARACTER_SELECT) return;
-
+    // The hero is created by finishLoading() once its spritesheet is on the GPU
     if (Input::isCharacter1Selected()) {
-        player = std::make_unique<SwordHero>();
-        startGame();
+        selectedHero = 1;
+        sceneStack.reset(getScene(GameState::LOADING));
     }
     else if (Input::isCharacter2Selected()) {
-        player = std::make_unique<GunHero>();
-        startGame();
+        selectedHero = 2;
+        sceneStack.reset(getScene(GameState::LOADING));
     }
     else if (Input::isCharacter3Selected()) {
-        player = std::make_unique<MagicHero>();
-        startGame();
+        selectedHero = 3;
+        sceneStack.reset(getScene(GameState::LOADING));
     }
     else if (Input::isEscapePressed()) {
-        state = GameState::MAIN_MENU;
+        sceneStack.reset(getScene(GameState::MAIN_MENU));
     }
 }
 
 void Game::handleSettings() {
-    if (state != GameState::SETTINGS) return;
-
     if (Input::isSettingsVolumeUpPressed()) {
         adjustVolume(10.0f);
     }
@@ -226,20 +391,18 @@ void Game::handleSettings() {
         toggleMusic();
     }
     else if (Input::isEscapePressed()) {
-        state = gameInProgress ? GameState::PAUSED_MENU : GameState::MAIN_MENU;
+        sceneStack.pop(); // back to the main or pause menu that opened it
     }
 }
 
 void Game::handleLeaderboard() {
-    if (state != GameState::LEADERBOARD) return;
-
     if (Input::isEscapePressed()) {
-        state = gameInProgress ? GameState::PAUSED_MENU : GameState::MAIN_MENU;
+        sceneStack.pop();
     }
 }
 
 void Game::handleGameInput() {
-    if (state != GameState::IN_GAME || !player) return;
+    if (!player) return;
 
     // Handle attack input
     if (Input::isAttackPressed()) {
@@ -248,7 +411,20 @@ void Game::handleGameInput() {
 
         // Set aim direction for all heroes (unified)
         player->setAimDirection(attackDir);
+        bool attackFires = player->canAttack(); // attack() does nothing during the cooldown
         player->attack();
+
+        // Muzzle / swing effect
+        if (attackFires) {
+            sf::Vector2f muzzle = player->getPosition() + attackDir * 20.f;
+            if (dynamic_cast<GunHero*>(player.get())) {
+                particles.emit(muzzle, attackDir, ParticleSystem::MUZZLE_FLASH);
+            } else if (dynamic_cast<MagicHero*>(player.get())) {
+                particles.emit(muzzle, attackDir, ParticleSystem::MAGIC_SPARK);
+            } else {
+                particles.emit(muzzle, attackDir, ParticleSystem::SWORD_SWISH);
+            }
+        }
     }
 
     // Handle skill input
@@ -258,13 +434,12 @@ void Game::handleGameInput() {
 
     // Handle pause input
     if (Input::isPausePressed()) {
-        state = GameState::PAUSED_MENU;
-        selectedOption = 0; // Reset to first option (Continue Game)
+        sceneStack.push(getScene(GameState::PAUSED_MENU));
     }
 
     // Handle escape input
     if (Input::isEscapePressed()) {
-        state = GameState::MAIN_MENU;
+        sceneStack.reset(getScene(GameState::MAIN_MENU));
         gameInProgress = false; // End game completely
     }
 
@@ -282,23 +457,26 @@ void Game::handleGameInput() {
     }
 }
 
-void Game::update() {
-    if (state == GameState::IN_GAME) {
-        updateGameplay();
-    }
-}
-
 void Game::updateGameplay() {
     if (!player || !player->getIsAlive()) {
         // Game over logic - save to leaderboard
         saveToLeaderboard();
         gameInProgress = false;
-        state = GameState::MAIN_MENU;
+        sceneStack.reset(getScene(GameState::MAIN_MENU));
         return;
     }
 
+    // Steady-state ticks must not touch the heap (checked in debug builds)
+    AllocationCounter::beginTick();
+
+    // Simulation time only advances here, so pausing freezes every cooldown and timer
+    SimClock::advance();
+
     // Update player
     player->update(gameMap.get());
+
+    // Stream world chunks around the player (loads happen on a worker thread)
+    gameMap->updateStreaming(player->getPosition());
     
     // Update player animation
     if (player) {
@@ -322,74 +500,32 @@ void Game::updateGameplay() {
     }
     #endif
 
-    // Update enemies
-    for (auto& enemy : enemies) {
-        enemy.update(player->getPosition(), gameMap.get());
-        // Update enemy animation
-        enemy.BaseObject::update(1.0f/ANIMATION_UPDATE_RATE); // Update animation using config rate
-        
-        #if ANIMATION_DEBUG_MODE && ANIMATION_SHOW_FRAME_INFO
-        // Debug: kiểm tra animation state
-        if (enemy.isAnimationEnabled() && enemy.getCurrentAnimation()) {
-            static int lastDebugFrame = -1;
-            int currentFrame = enemy.getCurrentAnimation()->getCurrentFrameIndex();
-            if (currentFrame != lastDebugFrame) {
-                std::cout << "Enemy update - Frame: " << currentFrame << "/" << enemy.getCurrentAnimation()->getFrameCount() << std::endl;
-                lastDebugFrame = currentFrame;
-            }
-        }
-        #endif
-    }
+    // Update enemies (LOD + time-sliced decisions)
+    updateEnemies();
 
-    // Remove dead enemies
-    enemies.erase(
-        std::remove_if(enemies.begin(), enemies.end(),
-            [this](const Enemy& enemy) {
-                if (!enemy.getIsAlive()) {
-                    score += 100;
-                    enemiesKilled++;
-                    player->gainExp(25);
-                    return true;
-                }
-                return false;
-            }),
-        enemies.end()
-    );
-
-    // Check collisions
+    // Check collisions, then apply damage and kills (also removes dead enemies)
     checkCollisions();
+    resolveCombatEvents();
+
+    // Particles run on simulation time too, so they freeze while paused
+    particles.update(1.0f / SimClock::TICKS_PER_SECOND);
 
     // Spawn new enemies
     spawnEnemies();
+
+    // Move far enemies to the dormant tier and wake dormant ones near the player
+    updateEnemyTiers();
+
+    AllocationCounter::endTick();
+
+    // Outside the tick check: rebinding a voice to another buffer may allocate in SFML
+    sounds.flush(player->getPosition());
 }
 
 void Game::render() {
     View::clear();
-
-    if (state == GameState::MAIN_MENU) {
-        renderMainMenu();
-    }
-    else if (state == GameState::PAUSED_MENU) {
-        renderPausedMenu();
-    }
-    else if (state == GameState::NAME_INPUT) {
-        renderNameInput();
-    }
-    else if (state == GameState::CHARACTER_SELECT) {
-        renderCharacterSelect();
-    }
-    else if (state == GameState::LEADERBOARD) {
-        renderLeaderboard();
-    }
-    else if (state == GameState::SETTINGS) {
-        renderSettings();
-    }
-    else if (state == GameState::IN_GAME) {
-        renderGameplay();
-        renderUI();
-    }
-
-    View::display();
+    sceneStack.render(); // Top scene (static menus come from a cached layer)
+    perfOverlay.draw(10.f, 390.f, lateInputSampling);
 }
 
 void Game::renderGameplay() {
@@ -433,8 +569,8 @@ void Game::renderGameplay() {
                 #if ANIMATION_DEBUG_MODE
                 // Debug: hiển thị enemy position và distance
                 static int lastDebugEnemy = -1;
-                if (enemy.getCurrentAnimation()) {
-                    int currentFrame = enemy.getCurrentAnimation()->getCurrentFrameIndex();
+                if (Enemy::hasSpritesheet()) {
+                    int currentFrame = enemy.getAnimationFrame();
                     if (currentFrame != lastDebugEnemy) {
                         std::cout << "Enemy visible at (" << enemyPos.x << ", " << enemyPos.y 
                                   << ") - Distance: " << distance << " - Frame: " << currentFrame << std::endl;
@@ -444,6 +580,9 @@ void Game::renderGameplay() {
                 #endif
             }
         }
+
+        // Particles over the characters: one draw call per blend mode
+        particles.draw(window, sf::FloatRect(cameraCenter.x - 400.0f, cameraCenter.y - 300.0f, 800.0f, 600.0f));
     }
 }
 
@@ -451,10 +590,33 @@ void Game::renderUI() {
     if (!player) return;
 
     // Calculate play time
-    float currentPlayTime = gameTimer.getElapsedTime().asSeconds();
+    float currentPlayTime = SimClock::ticksToSeconds(SimClock::now() - gameStartTick);
 
     // Use View system to draw HUD
     View::drawHUD(player.get(), score, enemiesKilled, currentPlayTime);
+
+    // Minimap: tiles come from its cached texture, every marker goes into one vertex array
+    if (gameMap) {
+        minimap.update(*gameMap, player->getPosition());
+        minimap.clearMarkers();
+        for (const auto& enemy : enemies) {
+            if (enemy.getIsAlive()) {
+                minimap.addMarker(enemy.getPosition(), sf::Color::Red);
+            }
+        }
+        if (auto* gunHero = dynamic_cast<GunHero*>(player.get())) {
+            for (const auto& bullet : gunHero->getBullets()) {
+                minimap.addMarker(bullet.getPosition(), sf::Color::Yellow, 2.f);
+            }
+        }
+        if (auto* magicHero = dynamic_cast<MagicHero*>(player.get())) {
+            for (const auto& bullet : magicHero->getBullets()) {
+                minimap.addMarker(bullet.getPosition(), sf::Color(160, 120, 255), 2.f);
+            }
+        }
+        minimap.addMarker(player->getPosition(), sf::Color::Green, 4.f);
+        View::drawMinimap(minimap);
+    }
 }
 
 void Game::renderMainMenu() {
@@ -469,8 +631,13 @@ void Game::renderMainMenu() {
 }
 
 void Game::renderPausedMenu() {
-    // Draw background first
-    View::drawMenuBackground();
+    // Background: the frozen gameplay frame (drawn by the scene stack), dimmed, with a panel behind the options
+    if (sceneStack.hasFrozenFrame()) {
+        View::drawFadeOverlay(0.55f);
+        View::drawRectangle(195, 240, 200, 250, sf::Color(255, 255, 255, 200), sf::Color::White, 2.f);
+    } else {
+        View::drawMenuBackground();
+    }
 
     // Draw title using View system
     View::drawText("GAME PAUSED", 400, 50, 40, View::getAccentColor(), true);
@@ -479,8 +646,8 @@ void Game::renderPausedMenu() {
     View::drawMenu(pausedMenuOptions, selectedOption, 250, 200, 50);
 
     // Draw instructions using View system
-    View::drawText("Press P to quickly resume", 400, 450, 16, View::getSecondaryColor(), true);
-    View::drawText("Use Arrow Keys and Enter to navigate", 400, 475, 16, View::getSecondaryColor(), true);
+    View::drawText("Press P to quickly resume", 400, 520, 16, View::getSecondaryColor(), true);
+    View::drawText("Use Arrow Keys and Enter to navigate", 400, 545, 16, View::getSecondaryColor(), true);
 }
 
 void Game::renderNameInput() {
@@ -522,6 +689,12 @@ void Game::renderCharacterSelect(){
     View::drawRectangle(180, 250, 40, 40, sf::Color::Magenta);
 }
 
+void Game::renderLoading() {
+    View::drawMenuBackground();
+    View::drawText("LOADING", 400, 240, 40, View::getAccentColor(), true);
+    View::drawProgressBar(200, 300, 400, 24, assets.getProgress(gameAssets), View::getPrimaryColor());
+}
+
 void Game::renderLeaderboard() {
     // Title using View system
     View::drawText("TOP 10 LEADERBOARD", 400, 50, 36, View::getAccentColor(), true);
@@ -535,10 +708,10 @@ void Game::renderLeaderboard() {
     View::drawText("Score", 350, 120, 18, View::getTextColor());
     View::drawText("Time", 450, 120, 18, View::getTextColor());
 
-    // read leaderboard.txt
+    // read leaderboard.txt (line buffers live in the frame arena)
     std::ifstream file("leaderboard.txt");
     if (file.is_open()) {
-        std::string line;
+        std::pmr::string line(FrameArena::getResource());
         int y = 150;
         int rank = 1;
         while (std::getline(file, line) && rank <= 10) {
@@ -547,16 +720,17 @@ void Game::renderLeaderboard() {
             size_t timePos = line.find("Time: ");
 
             if (scorePos != std::string::npos && timePos != std::string::npos) {
-                std::string name = line.substr(0, scorePos - 3);
-                std::string scoreStr = line.substr(scorePos + 7);
+                std::pmr::string name(line, 0, scorePos - 3, FrameArena::getResource());
+                std::pmr::string scoreStr(line, scorePos + 7, std::string::npos, FrameArena::getResource());
                 size_t scoreEnd = scoreStr.find(" - ");
                 if (scoreEnd != std::string::npos) {
-                    scoreStr = scoreStr.substr(0, scoreEnd);
+                    scoreStr.resize(scoreEnd);
                 }
-                std::string timeStr = line.substr(timePos + 6);
+                std::pmr::string timeStr(line, timePos + 6, std::string::npos, FrameArena::getResource());
                 // Truncate long names
                 if (name.length() > 15) {
-                    name = name.substr(0, 12) + "...";
+                    name.resize(12);
+                    name += "...";
                 }
 
                 // Color coding for ranks using View system
@@ -567,10 +741,10 @@ void Game::renderLeaderboard() {
                 else rankColor = sf::Color::White;
 
                 // Draw each column separately for proper alignment
-                View::drawText(std::to_string(rank) + ".", 50, y, 16, rankColor);
-                View::drawText(name, 150, y, 16, rankColor);
-                View::drawText(scoreStr, 350, y, 16, rankColor);
-                View::drawText(timeStr, 450, y, 16, rankColor);
+                View::drawText(FrameArena::format("%d.", rank), 50, y, 16, rankColor);
+                View::drawText(name.c_str(), 150, y, 16, rankColor);
+                View::drawText(scoreStr.c_str(), 350, y, 16, rankColor);
+                View::drawText(timeStr.c_str(), 450, y, 16, rankColor);
 
                 y += 25;
                 rank++;
@@ -585,22 +759,159 @@ void Game::renderLeaderboard() {
         View::drawText("No leaderboard data found", 400, 200, 20, sf::Color::Red, true);
     }
 }
+void Game::requestGameAssets() {
+    // With the atlas, one texture holds every sprite and tile
+    const unsigned char* tableData = nullptr;
+    std::size_t tableSize = 0;
+    bool atlasTable = assets.getFileData(ATLAS_TABLE_PATH, tableData, tableSize)
+                          ? SpriteAtlas::loadFromMemory(tableData, tableSize)
+                          : SpriteAtlas::load(AssetPaths::resolve(ATLAS_TABLE_PATH));
+    if (atlasTable) {
+        atlasAsset = assets.requestTexture(ATLAS_TEXTURE_PATH);
+        gameAssets = {atlasAsset};
+        return;
+    }
+
+    playerSpritesheetAsset = assets.requestTexture(PLAYER_SHEET.path);
+    enemySpritesheetAsset = assets.requestTexture(ENEMY_SPRITESHEET_PATH);
+    wallTextureAsset = assets.requestTexture(Map::WALL_TEXTURE_PATH);
+    floorTextureAsset = assets.requestTexture(Map::FLOOR_TEXTURE_PATH);
+    gameAssets = {playerSpritesheetAsset, enemySpritesheetAsset, wallTextureAsset, floorTextureAsset};
+}
+
+void Game::holdGameTextures() {
+    // The player, enemies and map point into these until the game is over
+    if (gameTexturesHeld) return;
+    gameTexturesHeld = true;
+    for (AssetLoader::Handle handle : gameAssets) {
+        assets.retain(handle);
+        assets.getTexture(handle); // one evicted in the menus reloads behind the loading screen
+    }
+}
+
+void Game::releaseGameTextures() {
+    if (!gameTexturesHeld) return;
+    gameTexturesHeld = false;
+    for (AssetLoader::Handle handle : gameAssets) {
+        assets.release(handle);
+    }
+}
+
+sf::Texture* Game::getLooseTexture(AssetLoader::Handle& handle, const char* path) {
+    // Loaded (blocking) the first time the atlas can't stand in for it, then held like the rest
+    if (!handle) {
+        handle = assets.loadTextureNow(path);
+    }
+    if (std::find(gameAssets.begin(), gameAssets.end(), handle) == gameAssets.end()) {
+        gameAssets.push_back(handle);
+        if (gameTexturesHeld) {
+            assets.retain(handle);
+        }
+    }
+    return assets.getTexture(handle);
+}
+
+void Game::holdMenuBackground() {
+    if (menuBackgroundHeld) return;
+    menuBackgroundHeld = true;
+    assets.retain(menuBackgroundAsset);
+    updateMenuBackground(); // if it was evicted, getTexture() has started the reload
+}
+
+void Game::releaseMenuBackground() {
+    // Gameplay doesn't draw it; View lets go first, since eviction may empty the texture
+    if (!menuBackgroundHeld) return;
+    menuBackgroundHeld = false;
+    View::clearMenuBackground();
+    assets.release(menuBackgroundAsset);
+}
+
+void Game::updateMenuBackground() {
+    if (!menuBackgroundHeld || View::hasMenuBackground() ||
+        assets.getStatus(menuBackgroundAsset) == AssetLoader::Status::FAILED) return;
+
+    sf::Texture* background = assets.getTexture(menuBackgroundAsset);
+    if (background && assets.getStatus(menuBackgroundAsset) == AssetLoader::Status::READY) {
+        View::setMenuBackground(*background);
+        sceneStack.invalidate(); // a static menu may already be on screen without it
+    }
+}
+
+void Game::finishLoading() {
+    // One enemy spritesheet for every enemy; spawning and waking never touch the disk.
+    // A missing or failed atlas falls back to the loose sheets.
+    sf::Texture* atlas = atlasAsset ? assets.getTexture(atlasAsset) : nullptr;
+    if (atlas && atlas->getSize().x == 0) {
+        atlas = nullptr;
+    }
+    if (!atlas && atlasAsset) {
+        // The table was there but its texture wasn't: the loose sheets load below instead
+        std::cerr << "Warning: " << ATLAS_TEXTURE_PATH << " failed to load, using the loose textures" << std::endl;
+        if (gameTexturesHeld) {
+            assets.release(atlasAsset); // nothing points into it
+        }
+        gameAssets.erase(std::remove(gameAssets.begin(), gameAssets.end(), atlasAsset), gameAssets.end());
+        atlasAsset = 0;
+    }
+    SpriteFrames playerFrames;
+    if (!atlas || !SpriteAtlas::getFrames("player", atlas, playerFrames)) {
+        playerFrames = SpriteFrames::wholeSheet(getLooseTexture(playerSpritesheetAsset, PLAYER_SHEET.path), PLAYER_SHEET.frameWidth,
+                                                PLAYER_SHEET.frameHeight, PLAYER_SHEET.frameCount,
+                                                sf::Vector2f(PLAYER_SHEET.scaleX, PLAYER_SHEET.scaleY));
+    }
+    if (!atlas || !SpriteAtlas::getFrames("enemy", atlas, enemyFrames)) {
+        enemyFrames = SpriteFrames::wholeSheet(getLooseTexture(enemySpritesheetAsset, ENEMY_SPRITESHEET_PATH), ENEMY_SHEET.frameWidth,
+                                               ENEMY_SHEET.frameHeight, ENEMY_SHEET.frameCount,
+                                               sf::Vector2f(ENEMY_SHEET.scaleX, ENEMY_SHEET.scaleY));
+    }
+    Enemy::setSpritesheet(enemyFrames);
+
+    if (selectedHero == 2) {
+        player = std::make_unique<GunHero>(&playerFrames);
+    } else if (selectedHero == 3) {
+        player = std::make_unique<MagicHero>(&playerFrames);
+    } else {
+        player = std::make_unique<SwordHero>(&playerFrames);
+    }
+    startGame();
+}
+
 void Game::startGame() {
     if (!player) {
         return; // Cannot start without player
     }
 
-    state = GameState::IN_GAME;
+    sceneStack.reset(getScene(GameState::IN_GAME));
     gameInProgress = true; // Mark game as in progress
+    releaseMenuBackground();
 
     // Create map
-    gameMap = std::make_unique<Map>();
+    std::string levelPath = AssetPaths::resolve(LEVEL_FILE_PATH);
+    if (std::ifstream(levelPath)) {
+        gameMap = std::make_unique<Map>(levelPath);
+    } else {
+        gameMap = std::make_unique<Map>(WORLD_WIDTH_TILES, WORLD_HEIGHT_TILES, Map::Storage::STREAMED);
+    }
+    sf::Texture* atlas = atlasAsset ? assets.getTexture(atlasAsset) : nullptr;
+    sf::IntRect wallRect, floorRect;
+    if (atlas && SpriteAtlas::getRect("wall", wallRect) &&
+        SpriteAtlas::getRect("floor", floorRect)) {
+        // Both tile layers on the atlas: no texture switch between them or the sprites
+        gameMap->setTextures(atlas, atlas, wallRect, floorRect);
+    } else {
+        gameMap->setTextures(getLooseTexture(wallTextureAsset, Map::WALL_TEXTURE_PATH),
+                             getLooseTexture(floorTextureAsset, Map::FLOOR_TEXTURE_PATH));
+    }
 
     // Reset game stats
     score = 0;
     enemiesKilled = 0;
-    gameTimer.restart();
-    enemySpawnTimer.restart();
+    gameStartTick = SimClock::now();
+    enemySpawnDue = false;
+    SimClock::getTimers().cancel(enemySpawnTimer);
+    enemySpawnTimer = SimClock::getTimers().schedule(SimClock::millisecondsToTicks(ENEMY_SPAWN_INTERVAL_MS), this,
+                                                     EVENT_SPAWN_ENEMY);
+    AllocationCounter::resetSteadyState();
 
     // Position player at spawn point
     if (player && gameMap) {
@@ -633,6 +944,12 @@ void Game::startGame() {
 
     // Clear and spawn initial enemies
     enemies.clear();
+    dormantEnemies.clear();
+    particles.clear();
+    sounds.stopAll();
+    enemyTierTick = 0;
+    aiTick = 0;
+    aiDecisionCursor = 0;
     const auto& spawnPoints = gameMap->getEnemySpawnPoints();
     
     #if ANIMATION_DEBUG_MODE
@@ -642,14 +959,11 @@ void Game::startGame() {
     #endif
     
     for (size_t i = 0; i < std::min(spawnPoints.size(), size_t(3)); i++) {
-        // Sử dụng emplace_back để tránh copy
-        enemies.emplace_back(spawnPoints[i].x, spawnPoints[i].y);
-        // Setup animation cho enemy vừa tạo
-        enemies.back().setupEnemyAnimation("../assets/Enemy_spritesheet.png", ENEMY_FRAME_WIDTH, ENEMY_FRAME_HEIGHT, ENEMY_FRAME_COUNT);
+        spawnEnemy(spawnPoints[i].x, spawnPoints[i].y);
         
         #if ANIMATION_DEBUG_MODE
         std::cout << "Initial enemy " << i << " spawned at (" << spawnPoints[i].x << ", " << spawnPoints[i].y << ")" << std::endl;
-        std::cout << "Enemy animation: " << (enemies.back().isAnimationEnabled() ? "ENABLED" : "DISABLED") << std::endl;
+        std::cout << "Enemy animation: " << (Enemy::hasSpritesheet() ? "ENABLED" : "DISABLED") << std::endl;
         #endif
     }
     
@@ -661,10 +975,76 @@ void Game::startGame() {
 
 void Game::continueGame() {
     if (gameInProgress && player && gameMap) {
-        state = GameState::IN_GAME;
+        sceneStack.reset(getScene(GameState::IN_GAME));
+        releaseMenuBackground();
     } else {
         playerName = ""; // Reset player name
-        state = GameState::NAME_INPUT;
+        sceneStack.reset(getScene(GameState::MAIN_MENU));
+        sceneStack.push(getScene(GameState::NAME_INPUT));
+    }
+}
+
+void Game::updateEnemies() {
+    if (enemies.empty()) return;
+
+    sf::Vector2f playerPos = player->getPosition();
+    aiTick++;
+
+    // Steering decisions: round-robin from where the last tick stopped, until the
+    // budget is spent. Reading the clock costs about as much as a decision, so it
+    // is only read every few decisions.
+    sf::Clock decisionClock;
+    size_t enemyCount = enemies.size();
+    if (aiDecisionCursor >= enemyCount) aiDecisionCursor = 0;
+    for (size_t visited = 0; visited < enemyCount; visited++) {
+        if (visited > 0 && visited % AI_BUDGET_CHECK_DECISIONS == 0 &&
+            decisionClock.getElapsedTime().asMicroseconds() >= AI_DECISION_BUDGET_MICROSECONDS) {
+            break;
+        }
+        enemies[aiDecisionCursor].think(playerPos, gameMap.get());
+        aiDecisionCursor = (aiDecisionCursor + 1) % enemyCount;
+    }
+
+    // Local avoidance for everyone, from k-nearest grid neighbours (O(n * k))
+    activeEnemyPositions.clear();
+    for (const auto& enemy : enemies) {
+        activeEnemyPositions.push_back(enemy.getPosition());
+    }
+    enemyFlocking.compute(activeEnemyPositions.data(), static_cast<int>(enemyCount), gameMap.get());
+    for (size_t i = 0; i < enemyCount; i++) {
+        enemies[i].setAvoidance(enemyFlocking.getSteering(static_cast<int>(i)));
+    }
+
+    // Movement at a rate that depends on distance to the player; each enemy's
+    // phase spreads the reduced-rate updates evenly over ticks
+    const float nearSq = AI_NEAR_RADIUS * AI_NEAR_RADIUS;
+    const float midSq = AI_MID_RADIUS * AI_MID_RADIUS;
+    for (auto& enemy : enemies) {
+        sf::Vector2f offset = enemy.getPosition() - playerPos;
+        float distanceSq = offset.x * offset.x + offset.y * offset.y;
+        int interval = distanceSq <= nearSq ? 1 : (distanceSq <= midSq ? AI_MID_INTERVAL : AI_FAR_INTERVAL);
+        if ((aiTick + enemy.getLodPhase()) % interval != 0) continue;
+
+        // Blocked enemies re-decide before they move instead of waiting their turn
+        if (enemy.needsDecision()) {
+            enemy.think(playerPos, gameMap.get());
+        }
+
+        enemy.update(playerPos, gameMap.get(), interval / 60.0f);
+        // Update enemy animation
+        enemy.animate(interval * (1.0f/ANIMATION_UPDATE_RATE)); // Update animation using config rate
+        
+        #if ANIMATION_DEBUG_MODE && ANIMATION_SHOW_FRAME_INFO
+        // Debug: kiểm tra animation state
+        if (Enemy::hasSpritesheet()) {
+            static int lastDebugFrame = -1;
+            int currentFrame = enemy.getAnimationFrame();
+            if (currentFrame != lastDebugFrame) {
+                std::cout << "Enemy update - Frame: " << currentFrame << "/" << enemy.getAnimationFrameCount() << std::endl;
+                lastDebugFrame = currentFrame;
+            }
+        }
+        #endif
     }
 }
 
@@ -676,115 +1056,177 @@ void Game::checkCollisions() {
     if (auto* gunHero = dynamic_cast<GunHero*>(player.get())) {
         auto& bullets = gunHero->getBullets();
 
-        for (size_t i = 0; i < bullets.size();) {
+        // A bullet hits the first enemy it touches; spent bullets are removed afterwards
+        size_t kept = 0;
+        for (size_t i = 0; i < bullets.size(); i++) {
             bool bulletHit = false;
 
-            for (auto& enemy : enemies) {
-                if (enemy.getIsAlive() &&
-                    bullets[i].getBounds().intersects(enemy.getBounds())) {
+            for (size_t e = 0; e < enemies.size(); e++) {
+                if (enemies[e].getIsAlive() &&
+                    bullets[i].getBounds().intersects(enemies[e].getBounds())) {
 
-                    enemy.takeDamage(bullets[i].getDamage());
-                    bullets.erase(bullets.begin() + i);
+                    combatEvents.pushDamage(static_cast<int>(e), bullets[i].getDamage(), DamageSource::BULLET, static_cast<int>(i));
                     bulletHit = true;
                     break;
                 }
             }
 
             if (!bulletHit) {
-                ++i;
+                if (kept != i) bullets[kept] = bullets[i];
+                kept++;
             }
         }
+        bullets.erase(bullets.begin() + kept, bullets.end());
     }
 
     // Check magic bullet vs enemy collisions for MagicHero
     if (auto* magicHero = dynamic_cast<MagicHero*>(player.get())) {
         auto& magicBullets = magicHero->getBullets();
 
-        for (size_t i = 0; i < magicBullets.size();) {
+        size_t kept = 0;
+        for (size_t i = 0; i < magicBullets.size(); i++) {
             bool bulletHit = false;
 
-            for (auto& enemy : enemies) {
-                if (enemy.getIsAlive() &&
-                    magicBullets[i].getBounds().intersects(enemy.getBounds())) {
+            for (size_t e = 0; e < enemies.size(); e++) {
+                if (enemies[e].getIsAlive() &&
+                    magicBullets[i].getBounds().intersects(enemies[e].getBounds())) {
 
-                    enemy.takeDamage(magicBullets[i].getDamage());
-                    magicBullets.erase(magicBullets.begin() + i);
+                    combatEvents.pushDamage(static_cast<int>(e), magicBullets[i].getDamage(), DamageSource::MAGIC_BULLET, static_cast<int>(i));
                     bulletHit = true;
                     break;
                 }
             }
 
             if (!bulletHit) {
-                ++i;
+                if (kept != i) magicBullets[kept] = magicBullets[i];
+                kept++;
             }
         }
+        magicBullets.erase(magicBullets.begin() + kept, magicBullets.end());
     }
 
-    // Check sword hero vs enemy collisions
+    // Check sword hero vs enemy collisions: exact swing/slash shape, enemies
+    // from the spatial grid, each enemy hit once per swing
     if (auto* swordHero = dynamic_cast<SwordHero*>(player.get())) {
-        if (swordHero->getIsAttacking()) { // Dùng getter thay vì truy cập trực tiếp
-            sf::FloatRect attackArea = swordHero->getAttackArea();
-
-            for (auto& enemy : enemies) {
-                if (enemy.getIsAlive() &&
-                    attackArea.intersects(enemy.getBounds())) {
-
-                    // Check if there's a wall between player and enemy
-                    sf::Vector2f playerPos = player->getPosition();
-                    sf::Vector2f enemyPos = enemy.getPosition();
-
-                    // Simple line-of-sight check
-                    bool wallBlocking = false;
-                    if (gameMap) {
-                        // Check a few points along the line between player and enemy
-                        for (float t = 0.1f; t < 1.0f; t += 0.2f) {
-                            sf::Vector2f checkPoint = playerPos + t * (enemyPos - playerPos);
-                            if (!gameMap->isPassable(checkPoint)) {
-                                wallBlocking = true;
-                                break;
-                            }
+        HitShape attackShape;
+        if (swordHero->getAttackShape(attackShape)) { // Dùng getter thay vì truy cập trực tiếp
+            meleeHits.begin(swordHero->getAttackId());
+
+            activeEnemyPositions.clear();
+            for (const auto& enemy : enemies) {
+                activeEnemyPositions.push_back(enemy.getPosition());
+            }
+            activeEnemyGrid.rebuild(activeEnemyPositions.data(), static_cast<int>(activeEnemyPositions.size()));
+
+            sf::Vector2f playerPos = player->getPosition();
+            int attackDamage = swordHero->getAttackDamage();
+            float queryRadius = attackShape.getBoundsRadius() + EnemyArchetypes::getMaxHitRadius();
+            activeEnemyGrid.queryRadius(attackShape.getBoundsCenter(), queryRadius, [&](int e) {
+                Enemy& enemy = enemies[e];
+                if (!enemy.getIsAlive() || !attackShape.intersectsCircle(enemy.getPosition(), enemy.getHitRadius())) {
+                    return;
+                }
+
+                // Check if there's a wall between player and enemy
+                sf::Vector2f enemyPos = enemy.getPosition();
+
+                // Simple line-of-sight check
+                if (gameMap) {
+                    // Check a few points along the line between player and enemy
+                    for (float t = 0.1f; t < 1.0f; t += 0.2f) {
+                        sf::Vector2f checkPoint = playerPos + t * (enemyPos - playerPos);
+                        if (!gameMap->isPassable(checkPoint)) {
+                            return; // wall blocking - may still be hit later in this swing
                         }
                     }
+                }
 
-                    if (!wallBlocking) {
-                        enemy.takeDamage(swordHero->getAttackDamage());
-                    }
+                if (meleeHits.registerHit(enemy.getId())) {
+                    combatEvents.pushDamage(e, attackDamage, DamageSource::SWORD, 0);
                 }
-            }
+            });
         }
     }
 
     // Check enemy vs player collisions
-    for (auto& enemy : enemies) {
+    for (size_t e = 0; e < enemies.size(); e++) {
+        Enemy& enemy = enemies[e];
         if (enemy.getIsAlive() &&
             enemy.getBounds().intersects(player->getBounds()) &&
             enemy.canAttack()) {
 
-            player->takeDamage(enemy.getDamage());
-            enemy.attackPlayer();
+            combatEvents.pushDamage(CombatEventQueue::PLAYER_TARGET, enemy.getDamage(), DamageSource::ENEMY_CONTACT, static_cast<int>(e));
+            enemy.attackPlayer(); // the enemy's own cooldown
+        }
+    }
+}
+
+void Game::resolveCombatEvents() {
+    // Damage in a fixed order, whatever order the collision code found it in
+    combatEvents.sortDamage();
+    for (const DamageEvent& event : combatEvents.getDamageEvents()) {
+        if (event.target == CombatEventQueue::PLAYER_TARGET) {
+            player->takeDamage(event.amount);
+            particles.emit(player->getPosition(), sf::Vector2f(0.f, -1.f), ParticleSystem::PLAYER_HIT);
+            sounds.play(SoundId::PLAYER_HURT, player->getPosition());
+            continue;
+        }
+
+        Enemy& enemy = enemies[event.target];
+        if (!enemy.getIsAlive()) continue; // already killed by an earlier event this tick
+        enemy.takeDamage(event.amount);
+        particles.emit(enemy.getPosition(), BaseObject::calculateDirection(player->getPosition(), enemy.getPosition()),
+                       event.source == DamageSource::MAGIC_BULLET ? ParticleSystem::MAGIC_SPARK : ParticleSystem::HIT_SPARK);
+        sounds.play(event.source == DamageSource::MAGIC_BULLET ? SoundId::MAGIC_HIT
+                    : event.source == DamageSource::SWORD      ? SoundId::SWORD_HIT
+                                                               : SoundId::HIT,
+                    enemy.getPosition());
+        if (!enemy.getIsAlive()) {
+            combatEvents.pushKill(enemy.getPosition(), enemy.getArchetypeIndex(), event.source);
         }
     }
+
+    // Kills: the single place for scoring, effects and telemetry
+    for (const KillEvent& kill : combatEvents.getKillEvents()) {
+        score += KILL_SCORE;
+        enemiesKilled++;
+        player->gainExp(KILL_EXP);
+        sounds.play(SoundId::ENEMY_DEATH, kill.position);
+        particles.emit(kill.position, sf::Vector2f(0.f, -1.f), ParticleSystem::DEATH_BURST,
+                       sf::Color(EnemyArchetypes::get(kill.archetype).tint));
+    }
+
+    // Remove dead enemies (event indices are invalid after this)
+    if (!combatEvents.getKillEvents().empty()) {
+        enemies.erase(
+            std::remove_if(enemies.begin(), enemies.end(),
+                [](const Enemy& enemy) { return !enemy.getIsAlive(); }),
+            enemies.end()
+        );
+    }
+
+    combatEvents.clear();
 }
 
 void Game::spawnEnemies() {
-    // Spawn enemies every 3 seconds, but limit active enemies
-    float spawnTime = enemySpawnTimer.getElapsedTime().asSeconds();
-    
+    // Spawn enemies every 3 seconds (see onTimer), but limit active enemies
     #if ANIMATION_DEBUG_MODE
-    static float lastDebugTime = -1.0f;
-    if (spawnTime - lastDebugTime > 1.0f) { // Log mỗi giây
-        std::cout << "Spawn timer: " << spawnTime << "s, Active enemies: " << enemies.size() << std::endl;
-        lastDebugTime = spawnTime;
+    static std::uint32_t lastDebugTick = 0;
+    if (SimClock::now() - lastDebugTick >= SimClock::TICKS_PER_SECOND) { // Log mỗi giây
+        std::cout << "Spawn due: " << (enemySpawnDue ? "yes" : "no") << ", Active enemies: " << enemies.size() << std::endl;
+        lastDebugTick = SimClock::now();
     }
     #endif
     
-    if (spawnTime > 3.0f && enemies.size() < 15) {
-        enemySpawnTimer.restart();
+    if (enemySpawnDue && enemies.size() < 15) {
+        enemySpawnDue = false;
+        enemySpawnTimer = SimClock::getTimers().schedule(SimClock::millisecondsToTicks(ENEMY_SPAWN_INTERVAL_MS), this,
+                                                         EVENT_SPAWN_ENEMY);
 
         const auto& spawnPoints = gameMap->getEnemySpawnPoints();
         if (!spawnPoints.empty() && player) {
             // Find spawn points within reasonable distance from player
-            std::vector<sf::Vector2f> nearbySpawns;
+            std::pmr::vector<sf::Vector2f> nearbySpawns(FrameArena::getResource());
             sf::Vector2f playerPos = player->getPosition();
 
             #if ANIMATION_DEBUG_MODE
@@ -816,18 +1258,13 @@ void Game::spawnEnemies() {
             if (!nearbySpawns.empty()) {
                 int randomIndex = rand() % nearbySpawns.size();
                 
-                // Tạo enemy trực tiếp trong vector để tránh copy/move
-                enemies.emplace_back(nearbySpawns[randomIndex].x, nearbySpawns[randomIndex].y);
-                
-                // Setup animation cho enemy vừa tạo
-                enemies.back().setupEnemyAnimation("../assets/Enemy_spritesheet.png", ENEMY_FRAME_WIDTH, ENEMY_FRAME_HEIGHT, ENEMY_FRAME_COUNT);
+                spawnEnemy(nearbySpawns[randomIndex].x, nearbySpawns[randomIndex].y);
                 
                 #if ANIMATION_DEBUG_MODE
                 std::cout << "Enemy spawned at: (" << nearbySpawns[randomIndex].x 
                           << ", " << nearbySpawns[randomIndex].y << ") - Total enemies: " 
                           << enemies.size() << std::endl;
-                std::cout << "Enemy animation state: " << (enemies.back().isAnimationEnabled() ? "ENABLED" : "DISABLED") << std::endl;
-                std::cout << "Enemy animation object: " << (enemies.back().getCurrentAnimation() ? "OK" : "NULL") << std::endl;
+                std::cout << "Enemy animation state: " << (Enemy::hasSpritesheet() ? "ENABLED" : "DISABLED") << std::endl;
                 
                 // Debug: kiểm tra distance từ player
                 float spawnDistance = std::sqrt(
@@ -850,55 +1287,66 @@ void Game::spawnEnemies() {
             #endif
         }
     }
+}
 
-    // Remove enemies that are too far from player to save memory
-    if (player) {
-        sf::Vector2f playerPos = player->getPosition();
-        size_t enemiesBefore = enemies.size();
-        
-        #if ANIMATION_DEBUG_MODE
-        std::cout << "=== ENEMY REMOVAL DEBUG ===" << std::endl;
-        std::cout << "Checking " << enemies.size() << " enemies for removal..." << std::endl;
-        #endif
-        
-        enemies.erase(
-            std::remove_if(enemies.begin(), enemies.end(),
-                [playerPos](const Enemy& enemy) {
-                    sf::Vector2f enemyPos = enemy.getPosition();
-                    float distance = std::sqrt(
-                        (enemyPos.x - playerPos.x) * (enemyPos.x - playerPos.x) +
-                        (enemyPos.y - playerPos.y) * (enemyPos.y - playerPos.y)
-                    );
-                    
-                    #if ANIMATION_DEBUG_MODE
-                    if (distance > 1000.0f) {
-                        std::cout << "Enemy at (" << enemyPos.x << ", " << enemyPos.y 
-                                  << ") will be removed - Distance: " << distance << std::endl;
-                    }
-                    #endif
-                    
-                    return distance > 1000.0f; // Giảm khoảng cách để enemy có thể vào tầm nhìn
-                }),
-            enemies.end()
-        );
-        
-        #if ANIMATION_DEBUG_MODE
-        if (enemies.size() != enemiesBefore) {
-            std::cout << "Enemies removed: " << (enemiesBefore - enemies.size()) 
-                      << " (distance > 1000)" << std::endl;
-            std::cout << "Remaining enemies: " << enemies.size() << std::endl;
-        } else {
-            std::cout << "No enemies removed" << std::endl;
+Enemy& Game::spawnEnemy(float x, float y, int archetype) {
+    if (archetype < 0) {
+        archetype = EnemyArchetypes::pickRandom(static_cast<unsigned int>(rand()));
+    }
+
+    // Tạo enemy trực tiếp trong vector để tránh copy/move (capacity is reserved)
+    enemies.emplace_back(x, y, archetype);
+    return enemies.back();
+}
+
+void Game::updateEnemyTiers() {
+    if (++enemyTierTick % ENEMY_TIER_UPDATE_TICKS != 0) return;
+
+    sf::Vector2f playerPos = player->getPosition();
+
+    // Index the active tier and keep everything the grid finds near the player
+    activeEnemyPositions.clear();
+    for (const auto& enemy : enemies) {
+        activeEnemyPositions.push_back(enemy.getPosition());
+    }
+    activeEnemyGrid.rebuild(activeEnemyPositions.data(), static_cast<int>(activeEnemyPositions.size()));
+    activeEnemyKeep.assign(enemies.size(), 0);
+    activeEnemyGrid.queryRadius(playerPos, ENEMY_SLEEP_RADIUS, [this](int index) {
+        activeEnemyKeep[index] = 1;
+    });
+
+    // Demote the rest into the dormant store (keeps position and HP)
+    for (int i = static_cast<int>(enemies.size()) - 1; i >= 0; i--) {
+        if (activeEnemyKeep[i] || !enemies[i].getIsAlive()) continue;
+
+        dormantEnemies.add(enemies[i].getPosition(), enemies[i].getHp(), enemies[i].getArchetypeIndex(), playerPos);
+        if (i != static_cast<int>(enemies.size()) - 1) {
+            enemies[i] = enemies.back();
         }
-        std::cout << "=== END REMOVAL DEBUG ===" << std::endl;
-        #endif
+        enemies.pop_back();
+    }
+
+    // Simplified simulation for the dormant tier, then wake the ones close to the player
+    dormantEnemies.update(gameMap.get(), ENEMY_TIER_UPDATE_TICKS / 60.0f, 40.0f);
+
+    int room = MAX_ACTIVE_ENEMIES - static_cast<int>(enemies.size());
+    if (room > 0) {
+        dormantEnemies.wakeWithin(playerPos, ENEMY_WAKE_RADIUS, room, [this](sf::Vector2f position, int hp, int archetype) {
+            spawnEnemy(position.x, position.y, archetype).setHp(hp);
+        });
     }
 }
 
 void Game::initializeAudio() {
-    // Load background music
-    if (!backgroundMusic.openFromFile("assets/background_music.mp3")) {
-        std::cerr << "Warning: Could not load background music from assets/background_music.mp3" << std::endl;
+    // Streamed, never decoded whole: from the mapped pack if it holds the track
+    // (the pack stays mapped for the game's lifetime), else from the loose file
+    const unsigned char* musicData = nullptr;
+    std::size_t musicSize = 0;
+    bool opened = assets.getFileData(MUSIC_PATH, musicData, musicSize)
+                      ? backgroundMusic.openFromMemory(musicData, musicSize)
+                      : backgroundMusic.openFromFile(AssetPaths::resolve(MUSIC_PATH));
+    if (!opened) {
+        std::cerr << "Warning: Could not load background music from " << MUSIC_PATH << std::endl;
         musicEnabled = false;
         return;
     }
@@ -979,7 +1427,7 @@ std::string Game::formatTime(float seconds) {
 void Game::saveToLeaderboard() {
     if (!player) return;
 
-    float playTime = gameTimer.getElapsedTime().asSeconds();
+    float playTime = SimClock::ticksToSeconds(SimClock::now() - gameStartTick);
     std::string playerName = player->getName();
 
     // Read existing leaderboard
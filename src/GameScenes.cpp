@@ -0,0 +1,133 @@
+#include "../include/Game.h"
+
+// The game's screens. Each one only forwards to the Game functions for its
+// screen; they are nested in Game so they can reach its state directly.
+
+class Game::MainMenuScene : public Scene {
+private:
+    Game& game;
+
+public:
+    explicit MainMenuScene(Game& game) : Scene(GameState::MAIN_MENU), game(game) {}
+
+    void onEnter() override {
+        game.holdMenuBackground();
+        if (!game.gameInProgress) {
+            game.releaseGameTextures(); // the game is over: the menus don't draw them
+        }
+    }
+    void update() override { game.handleMainMenuInput(); }
+    void render() override { game.renderMainMenu(); }
+    bool isStatic() const override { return true; }
+};
+
+class Game::PausedMenuScene : public Scene {
+private:
+    Game& game;
+
+public:
+    explicit PausedMenuScene(Game& game) : Scene(GameState::PAUSED_MENU), game(game) {}
+
+    void onEnter() override { game.selectedOption = 0; } // Continue Game
+    void update() override { game.handlePausedMenuInput(); }
+    void render() override { game.renderPausedMenu(); }
+    bool showsSceneBelow() const override { return true; }
+    bool isStatic() const override { return true; }
+};
+
+class Game::NameInputScene : public Scene {
+private:
+    Game& game;
+
+public:
+    explicit NameInputScene(Game& game) : Scene(GameState::NAME_INPUT), game(game) {}
+
+    void handleEvent(const sf::Event& event) override { game.handleNameInputEvent(event); }
+    void update() override {}
+    void render() override { game.renderNameInput(); }
+    bool isStatic() const override { return true; }
+};
+
+class Game::CharacterSelectScene : public Scene {
+private:
+    Game& game;
+
+public:
+    explicit CharacterSelectScene(Game& game) : Scene(GameState::CHARACTER_SELECT), game(game) {}
+
+    void update() override { game.handleCharacterSelection(); }
+    void render() override { game.renderCharacterSelect(); }
+    bool isStatic() const override { return true; }
+};
+
+class Game::LeaderboardScene : public Scene {
+private:
+    Game& game;
+
+public:
+    explicit LeaderboardScene(Game& game) : Scene(GameState::LEADERBOARD), game(game) {}
+
+    void update() override { game.handleLeaderboard(); }
+    void render() override { game.renderLeaderboard(); } // reads leaderboard.txt, so only on redraw
+    bool isStatic() const override { return true; }
+};
+
+class Game::SettingsScene : public Scene {
+private:
+    Game& game;
+
+public:
+    explicit SettingsScene(Game& game) : Scene(GameState::SETTINGS), game(game) {}
+
+    void update() override { game.handleSettings(); }
+    void render() override { game.renderSettings(); }
+    bool isStatic() const override { return true; }
+};
+
+class Game::GameplayScene : public Scene {
+private:
+    Game& game;
+
+public:
+    explicit GameplayScene(Game& game) : Scene(GameState::IN_GAME), game(game) {}
+
+    void update() override {
+        game.handleGameInput();
+        if (!game.sceneStack.hasPendingChanges()) { // paused or quit this frame: no tick
+            game.updateGameplay();
+        }
+    }
+    void render() override {
+        game.renderGameplay();
+        game.renderUI();
+    }
+};
+
+class Game::LoadingScene : public Scene {
+private:
+    Game& game;
+
+public:
+    explicit LoadingScene(Game& game) : Scene(GameState::LOADING), game(game) {}
+
+    void onEnter() override { game.holdGameTextures(); }
+
+    void update() override {
+        if (game.assets.getProgress(game.gameAssets) >= 1.f) { // loaded or failed, every one
+            game.finishLoading();
+        }
+    }
+    void render() override { game.renderLoading(); } // redrawn every frame: the bar moves
+};
+
+void Game::createScenes() {
+    scenes.resize(static_cast<int>(GameState::EXIT) + 1);
+    scenes[static_cast<int>(GameState::MAIN_MENU)] = std::make_unique<MainMenuScene>(*this);
+    scenes[static_cast<int>(GameState::PAUSED_MENU)] = std::make_unique<PausedMenuScene>(*this);
+    scenes[static_cast<int>(GameState::NAME_INPUT)] = std::make_unique<NameInputScene>(*this);
+    scenes[static_cast<int>(GameState::CHARACTER_SELECT)] = std::make_unique<CharacterSelectScene>(*this);
+    scenes[static_cast<int>(GameState::LEADERBOARD)] = std::make_unique<LeaderboardScene>(*this);
+    scenes[static_cast<int>(GameState::SETTINGS)] = std::make_unique<SettingsScene>(*this);
+    scenes[static_cast<int>(GameState::IN_GAME)] = std::make_unique<GameplayScene>(*this);
+    scenes[static_cast<int>(GameState::LOADING)] = std::make_unique<LoadingScene>(*this);
+}
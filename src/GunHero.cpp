@@ -4,7 +4,7 @@
 #include <iostream>
 #include <cmath>
 
-GunHero::GunHero() {
+GunHero::GunHero(const SpriteFrames* frames) {
     shape.setFillColor(sf::Color::Green); // màu xanh lá
 
     // Set GunHero-specific combat parameters
@@ -13,7 +13,7 @@ GunHero::GunHero() {
     skillUnlockLevel = 10;   // Unlock at level 10
     
     // Setup GunHero animation from spritesheet using config values
-    setupPlayerAnimation("../assets/Gun_player_spritesheet.png", PLAYER_FRAME_WIDTH, PLAYER_FRAME_HEIGHT, PLAYER_FRAME_COUNT);
+    setupPlayerAnimation(frames);
 }
 
 void GunHero::update(const Map* map) {
@@ -0,0 +1,38 @@
+#include "../include/HitRegistry.h"
+#include <algorithm>
+
+HitRegistry::HitRegistry(int capacity)
+    : currentStamp(1), currentAttack(0), count(0) {
+    std::uint32_t slots = 1;
+    while (slots < static_cast<std::uint32_t>(capacity)) {
+        slots <<= 1;
+    }
+    mask = slots - 1;
+    ids.assign(slots, 0);
+    stamps.assign(slots, 0);
+}
+
+void HitRegistry::begin(std::uint32_t attackId) {
+    if (attackId == currentAttack) return;
+    currentAttack = attackId;
+    count = 0;
+    if (++currentStamp == 0) {
+        // Stamp wrapped around: old slots could look current again
+        std::fill(stamps.begin(), stamps.end(), 0);
+        currentStamp = 1;
+    }
+}
+
+bool HitRegistry::registerHit(std::uint32_t targetId) {
+    if (count > static_cast<int>(mask)) return false; // full
+
+    std::uint32_t slot = (targetId * 2654435761u) & mask;
+    while (stamps[slot] == currentStamp) {
+        if (ids[slot] == targetId) return false; // already hit by this attack
+        slot = (slot + 1) & mask;
+    }
+    stamps[slot] = currentStamp;
+    ids[slot] = targetId;
+    count++;
+    return true;
+}
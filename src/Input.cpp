@@ -8,29 +8,33 @@ sf::RenderWindow* Input::window = nullptr;
 Camera* Input::camera = nullptr;
 InputConfig Input::config = InputConfig(); // Default config
 sf::Vector2i Input::lastMousePosition = sf::Vector2i(0, 0);
-bool Input::leftMousePressed = false;
-bool Input::rightMousePressed = false;
-bool Input::previousLeftMousePressed = false;
-bool Input::previousRightMousePressed = false;
-bool Input::keyStates[sf::Keyboard::KeyCount] = {false};
-bool Input::previousKeyStates[sf::Keyboard::KeyCount] = {false};
+std::uint32_t Input::mouseDown = 0;
+std::uint32_t Input::mousePressedLatch = 0;
+std::uint32_t Input::mouseStates = 0;
+std::uint32_t Input::previousMouseStates = 0;
+std::uint64_t Input::keysDown[KEY_WORDS] = {0};
+std::uint64_t Input::keysPressedLatch[KEY_WORDS] = {0};
+std::uint64_t Input::keyStates[KEY_WORDS] = {0};
+std::uint64_t Input::previousKeyStates[KEY_WORDS] = {0};
+sf::Time Input::pendingInputTime;
+bool Input::hasPendingInput = false;
+sf::Time Input::sampledInputTime;
+bool Input::hasSampledInput = false;
 
 void Input::initialize(sf::RenderWindow* gameWindow, Camera* gameCamera) {
     window = gameWindow;
     camera = gameCamera;
     
     // Initialize all key states to false
-    for (int i = 0; i < sf::Keyboard::KeyCount; i++) {
-        keyStates[i] = false;
-        previousKeyStates[i] = false;
+    for (int w = 0; w < KEY_WORDS; w++) {
+        keysDown[w] = keysPressedLatch[w] = keyStates[w] = previousKeyStates[w] = 0;
     }
     
-    // Initialize mouse state
+    // Initialize mouse state (the only position query; MouseMoved events keep it current)
     if (window) {
         lastMousePosition = sf::Mouse::getPosition(*window);
     }
-    leftMousePressed = false;
-    rightMousePressed = false;
+    mouseDown = mousePressedLatch = mouseStates = previousMouseStates = 0;
 }
 
 void Input::setCamera(Camera* gameCamera) {
@@ -45,33 +49,88 @@ InputConfig Input::getConfig() {
     return config;
 }
 
+void Input::handleEvent(const sf::Event& event, sf::Time timestamp) {
+    if (!hasPendingInput && (event.type == sf::Event::KeyPressed || event.type == sf::Event::MouseButtonPressed ||
+                             event.type == sf::Event::MouseMoved)) {
+        pendingInputTime = timestamp;
+        hasPendingInput = true;
+    }
+
+    switch (event.type) {
+        case sf::Event::KeyPressed:
+            if (event.key.code >= 0 && event.key.code < sf::Keyboard::KeyCount) {
+                std::uint64_t bit = std::uint64_t(1) << (event.key.code & 63);
+                keysDown[event.key.code >> 6] |= bit;
+                keysPressedLatch[event.key.code >> 6] |= bit;
+            }
+            break;
+        case sf::Event::KeyReleased:
+            if (event.key.code >= 0 && event.key.code < sf::Keyboard::KeyCount) {
+                keysDown[event.key.code >> 6] &= ~(std::uint64_t(1) << (event.key.code & 63));
+            }
+            break;
+        case sf::Event::MouseButtonPressed:
+            mouseDown |= 1u << event.mouseButton.button;
+            mousePressedLatch |= 1u << event.mouseButton.button;
+            lastMousePosition = sf::Vector2i(event.mouseButton.x, event.mouseButton.y);
+            break;
+        case sf::Event::MouseButtonReleased:
+            mouseDown &= ~(1u << event.mouseButton.button);
+            lastMousePosition = sf::Vector2i(event.mouseButton.x, event.mouseButton.y);
+            break;
+        case sf::Event::MouseMoved:
+            lastMousePosition = sf::Vector2i(event.mouseMove.x, event.mouseMove.y);
+            break;
+        case sf::Event::LostFocus:
+            // Releases that happen while unfocused never arrive - drop everything held
+            for (int w = 0; w < KEY_WORDS; w++) {
+                keysDown[w] = 0;
+            }
+            mouseDown = 0;
+            break;
+        default:
+            break;
+    }
+}
+
 void Input::update() {
-    if (!window) return;
-    
-    // Update previous key states
-    for (int i = 0; i < sf::Keyboard::KeyCount; i++) {
-        previousKeyStates[i] = keyStates[i];
-        keyStates[i] = sf::Keyboard::isKeyPressed(static_cast<sf::Keyboard::Key>(i));
+    // Snapshot: held now, or pressed at any point since the last update
+    for (int w = 0; w < KEY_WORDS; w++) {
+        previousKeyStates[w] = keyStates[w];
+        keyStates[w] = keysDown[w] | keysPressedLatch[w];
+        keysPressedLatch[w] = 0;
     }
     
     // Update mouse state
-    lastMousePosition = sf::Mouse::getPosition(*window);
-    previousLeftMousePressed = leftMousePressed;
-    previousRightMousePressed = rightMousePressed;
-    leftMousePressed = sf::Mouse::isButtonPressed(sf::Mouse::Left);
-    rightMousePressed = sf::Mouse::isButtonPressed(sf::Mouse::Right);
+    previousMouseStates = mouseStates;
+    mouseStates = mouseDown | mousePressedLatch;
+    mousePressedLatch = 0;
+
+    sampledInputTime = pendingInputTime;
+    hasSampledInput = hasPendingInput;
+    hasPendingInput = false;
+}
+
+bool Input::getSampledInputTime(sf::Time& timestamp) {
+    if (!hasSampledInput) return false;
+    timestamp = sampledInputTime;
+    return true;
 }
 
 bool Input::isKeyPressed(sf::Keyboard::Key key) {
-    return keyStates[key];
+    return testBit(keyStates, key);
 }
 
 bool Input::isKeyJustPressed(sf::Keyboard::Key key) {
-    return keyStates[key] && !previousKeyStates[key];
+    if (key < 0 || key >= sf::Keyboard::KeyCount) return false;
+    int w = key >> 6;
+    return ((keyStates[w] ^ previousKeyStates[w]) & keyStates[w]) >> (key & 63) & 1u;
 }
 
 bool Input::isKeyJustReleased(sf::Keyboard::Key key) {
-    return !keyStates[key] && previousKeyStates[key];
+    if (key < 0 || key >= sf::Keyboard::KeyCount) return false;
+    int w = key >> 6;
+    return ((keyStates[w] ^ previousKeyStates[w]) & previousKeyStates[w]) >> (key & 63) & 1u;
 }
 
 sf::Vector2f Input::getMovementDirection() {
@@ -102,19 +161,19 @@ sf::Vector2f Input::getArrowKeyInput() {
 }
 
 bool Input::isLeftMousePressed() {
-    return leftMousePressed;
+    return (mouseStates >> sf::Mouse::Left) & 1u;
 }
 
 bool Input::isRightMousePressed() {
-    return rightMousePressed;
+    return (mouseStates >> sf::Mouse::Right) & 1u;
 }
 
 bool Input::isLeftMouseJustPressed() {
-    return leftMousePressed && !previousLeftMousePressed;
+    return ((mouseStates ^ previousMouseStates) & mouseStates) >> sf::Mouse::Left & 1u;
 }
 
 bool Input::isRightMouseJustPressed() {
-    return rightMousePressed && !previousRightMousePressed;
+    return ((mouseStates ^ previousMouseStates) & mouseStates) >> sf::Mouse::Right & 1u;
 }
 
 sf::Vector2i Input::getMousePosition() {
@@ -124,8 +183,8 @@ sf::Vector2i Input::getMousePosition() {
 sf::Vector2f Input::getWorldMousePosition() {
     if (!window) return sf::Vector2f(0, 0);
 
-    // Get current mouse position (not cached) for more accuracy
-    sf::Vector2i currentMousePos = sf::Mouse::getPosition(*window);
+    // Position from the latest MouseMoved event, no round trip to the OS
+    sf::Vector2i currentMousePos = lastMousePosition;
     sf::Vector2f worldMousePos;
 
     // Use camera to convert screen coordinates to world coordinates
@@ -165,14 +224,14 @@ float Input::getAngle(sf::Vector2f vector) {
 }
 
 bool Input::isAnyKeyPressed() {
-    for (int i = 0; i < sf::Keyboard::KeyCount; i++) {
-        if (keyStates[i]) return true;
+    for (int w = 0; w < KEY_WORDS; w++) {
+        if (keyStates[w]) return true;
     }
     return false;
 }
 
 bool Input::isAnyMouseButtonPressed() {
-    return leftMousePressed || rightMousePressed;
+    return mouseStates != 0;
 }
 
 sf::Vector2f Input::getMouseDelta() {
@@ -259,7 +318,15 @@ bool Input::isSettingsMusicTogglePressed() {
     return isKeyJustPressed(sf::Keyboard::M);
 }
 
-bool Input::handleTextInput(sf::Event& event, std::string& text, int maxLength) {
+bool Input::isPerfOverlayTogglePressed() {
+    return isKeyJustPressed(sf::Keyboard::F3);
+}
+
+bool Input::isInputSamplingTogglePressed() {
+    return isKeyJustPressed(sf::Keyboard::F4);
+}
+
+bool Input::handleTextInput(const sf::Event& event, std::string& text, int maxLength) {
     if (event.type != sf::Event::TextEntered) return false;
     if (event.text.unicode >= 128) return false; // Only ASCII characters
 
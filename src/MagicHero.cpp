@@ -4,7 +4,7 @@
 #include <iostream>
 #include <cmath>
 
-MagicHero::MagicHero() {
+MagicHero::MagicHero(const SpriteFrames* frames) {
     shape.setFillColor(sf::Color::Magenta); // Magic color
 
     // Set MagicHero-specific combat parameters
@@ -13,7 +13,7 @@ MagicHero::MagicHero() {
     skillUnlockLevel = 5;    // Unlock earlier at level 5
     
     // Setup MagicHero animation from spritesheet using config values
-    setupPlayerAnimation("../assets/Gun_player_spritesheet.png", PLAYER_FRAME_WIDTH, PLAYER_FRAME_HEIGHT, PLAYER_FRAME_COUNT);
+    setupPlayerAnimation(frames);
 }
 
 void MagicHero::update(const Map* map) {
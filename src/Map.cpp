@@ -1,137 +1,142 @@
 #include "../include/Map.h"
+#include "../include/MapFile.h"
+#include "../include/DungeonGenerator.h"
+#include "../include/AssetPaths.h"
 #include <iostream>
 #include <cmath>
 #include <cstdlib>
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
 
-Map::Map() {
-    // Initialize tiles vector
-    tiles.resize(MAP_WIDTH, std::vector<Tile>(MAP_HEIGHT));
-
-    loadTextures();
-    initializeRoom();
-    createWalls();
-    createDoors();
-    setSpawnPoints();
+Map::Map() : Map(DEFAULT_WIDTH, DEFAULT_HEIGHT, Storage::RESIDENT) {
 }
 
-void Map::loadTextures() {
-    wallTexture.loadFromFile("assets/wall.png");
-    floorTexture.loadFromFile("assets/floor.png");
-}
-
-void Map::initializeRoom() {
-    // Khởi tạo tất cả tiles là EMPTY
-    for (int x = 0; x < MAP_WIDTH; x++) {
-        for (int y = 0; y < MAP_HEIGHT; y++) {
-            tiles[x][y].type = TileType::EMPTY;
-            tiles[x][y].isPassable = true;
-            tiles[x][y].shape.setPosition(x * TILE_SIZE, y * TILE_SIZE);
-            tiles[x][y].shape.setTexture(&floorTexture); // Set floor texture
+Map::Map(int widthInTiles, int heightInTiles, Storage storage)
+    : width(widthInTiles), height(heightInTiles),
+      chunksX((widthInTiles + WorldChunk::SIZE - 1) / WorldChunk::SIZE),
+      chunksY((heightInTiles + WorldChunk::SIZE - 1) / WorldChunk::SIZE),
+      seed(static_cast<unsigned int>(rand())), tileData(nullptr), sectorsX(0), sectorsY(0), sectorUseCounter(0),
+      wallTexture(&ownWallTexture), floorTexture(&ownFloorTexture), renderFrame(0), tileRevision(1) {
+    renderChunks.resize(RENDER_CHUNK_CACHE_SIZE);
+
+    if (storage == Storage::STREAMED) {
+        // The last row and column of sectors take whatever is left of the map
+        sectorsX = std::max(1, width / SECTOR_TILES);
+        sectorsY = std::max(1, height / SECTOR_TILES);
+        sectorCache.resize(SECTOR_CACHE_SIZE);
+        streamer = std::make_unique<ChunkStreamer>(chunksX, chunksY,
+            [this](int chunkX, int chunkY, WorldChunk& chunk) { generateChunk(chunkX, chunkY, chunk); });
+
+        // The player starts on the validated start tile of the sector holding the map centre
+        DungeonGenerator::TilePos start;
+        bool startValid;
+        {
+            std::lock_guard<std::mutex> lock(sectorMutex);
+            const Sector& sector = getSector(std::min(width / 2 / SECTOR_TILES, sectorsX - 1),
+                                             std::min(height / 2 / SECTOR_TILES, sectorsY - 1));
+            start = sector.start;
+            startValid = sector.valid;
         }
+
+        // Load the start area synchronously so the first frame has a world to stand on
+        streamer->prefetch(std::min(start.x >> WorldChunk::SHIFT, chunksX - 1),
+                           std::min(start.y >> WorldChunk::SHIFT, chunksY - 1), ChunkStreamer::DEFAULT_LOAD_RADIUS);
+
+        // Spawn points come from resident chunks, so the list never outgrows the budget
+        enemySpawnPoints.reserve(streamer->getBudget() * WorldChunk::MAX_SPAWNS);
+        playerSpawnPoint = startValid ? tileToWorld(sf::Vector2i(start.x, start.y))
+                                      : findSafeSpawnPoint(sf::Vector2f(width * TILE_SIZE / 2, height * TILE_SIZE / 2), 100.0f);
+        rebuildStreamedSpawnPoints();
+    } else {
+        allocateResident(width, height);
+        generateDungeon();
     }
+
+    std::cout << "Map " << width << "x" << height << (streamer ? " (streamed)" : "")
+              << " tile storage: " << getTileMemoryBytes() << " bytes" << std::endl;
 }
 
-void Map::createWalls() {
-    // Tạo tường bao quanh map
-    for (int x = 0; x < MAP_WIDTH; x++) {
-        // Tường trên và dưới
-        tiles[x][0].type = TileType::WALL;
-        tiles[x][0].isPassable = false;
-        tiles[x][0].shape.setTexture(&wallTexture); // Set wall texture
+Map::Map(const std::string& path)
+    : width(0), height(0), chunksX(0), chunksY(0), seed(static_cast<unsigned int>(rand())), tileData(nullptr),
+      sectorsX(0), sectorsY(0), sectorUseCounter(0),
+      wallTexture(&ownWallTexture), floorTexture(&ownFloorTexture), renderFrame(0), tileRevision(1) {
+    renderChunks.resize(RENDER_CHUNK_CACHE_SIZE);
 
-        tiles[x][MAP_HEIGHT-1].type = TileType::WALL;
-        tiles[x][MAP_HEIGHT-1].isPassable = false;
-        tiles[x][MAP_HEIGHT-1].shape.setTexture(&wallTexture); // Set wall texture
+    // Only generate when there is no usable file
+    if (!loadFromFile(path)) {
+        allocateResident(DEFAULT_WIDTH, DEFAULT_HEIGHT);
+        generateDungeon();
     }
+}
 
+void Map::allocateResident(int widthInTiles, int heightInTiles) {
+    width = widthInTiles;
+    height = heightInTiles;
+    chunksX = (widthInTiles + WorldChunk::SIZE - 1) / WorldChunk::SIZE;
+    chunksY = (heightInTiles + WorldChunk::SIZE - 1) / WorldChunk::SIZE;
 
-    for (int y = 0; y < MAP_HEIGHT; y++) {
-        // Tường trái và phải
-        tiles[0][y].type = TileType::WALL;
-        tiles[0][y].isPassable = false;
-        tiles[0][y].shape.setTexture(&wallTexture); // Set wall texture
-
-        tiles[MAP_WIDTH-1][y].type = TileType::WALL;
-        tiles[MAP_WIDTH-1][y].isPassable = false;
-        tiles[MAP_WIDTH-1][y].shape.setTexture(&wallTexture); // Set wall texture
-    }
+    // Single flat tile array, chunk-major (padded to whole chunks)
+    tiles.assign(static_cast<std::size_t>(chunksX) * chunksY * WorldChunk::TILE_COUNT, Tile(TileType::WALL));
+    tileData = tiles.data();
+}
 
-    // Tạo một số cụm tường nhỏ rải rác trong map
-    for (int cluster = 0; cluster < 50; cluster++) {
+void Map::loadTextures() {
+    ownWallTexture.loadFromFile(AssetPaths::resolve(WALL_TEXTURE_PATH));
+    ownFloorTexture.loadFromFile(AssetPaths::resolve(FLOOR_TEXTURE_PATH));
+    ownTextureCharge.set(MemoryBudget::bytesOf(ownWallTexture) + MemoryBudget::bytesOf(ownFloorTexture));
+    setTextures(&ownWallTexture, &ownFloorTexture);
+}
 
-        int centerX = 10 + (rand() % (MAP_WIDTH - 20));
-        int centerY = 10 + (rand() % (MAP_HEIGHT - 20));
+void Map::setTextures(const sf::Texture* wall, const sf::Texture* floor,
+                      const sf::IntRect& wallRect, const sf::IntRect& floorRect) {
+    wallTexture = wall ? wall : &ownWallTexture;
+    floorTexture = floor ? floor : &ownFloorTexture;
 
-        // Avoid creating walls near center spawn area (larger safe zone)
-        int mapCenterX = MAP_WIDTH / 2;
-        int mapCenterY = MAP_HEIGHT / 2;
-        if (abs(centerX - mapCenterX) < 5 && abs(centerY - mapCenterY) < 5) continue;
+    sf::Vector2f wallSize(wallTexture->getSize());
+    sf::Vector2f floorSize(floorTexture->getSize());
+    wallTextureRect = wallRect.width > 0 ? sf::FloatRect(wallRect) : sf::FloatRect(0.f, 0.f, wallSize.x, wallSize.y);
+    floorTextureRect = floorRect.width > 0 ? sf::FloatRect(floorRect) : sf::FloatRect(0.f, 0.f, floorSize.x, floorSize.y);
+    invalidateAllRenderChunks(); // texture coordinates are baked into the vertices
+}
 
-        // Tạo cụm tường 2x2 thay vì 3x3 để không quá đông
-        for (int dx = 0; dx <= 1; dx++) {
-            for (int dy = 0; dy <= 1; dy++) {
-                int x = centerX + dx;
-                int y = centerY + dy;
+void Map::generateDungeon() {
+    // BSP rooms + corridors with doors; every floor tile is reachable from the start
+    DungeonSettings settings;
+    settings.spawnCount = std::max(50, width * height / 150);
+    settings.minSpawnDistance = 200 / TILE_SIZE + 1; // Tối thiểu 200 pixels từ player
+
+    sf::Clock generationTimer;
+    DungeonGenerator generator(width, height, seed, settings);
+    if (!generator.generate()) {
+        std::cerr << "Map " << width << "x" << height << " is too small for a dungeon (minimum "
+                  << DungeonGenerator::MIN_SIZE << "x" << DungeonGenerator::MIN_SIZE << ")" << std::endl;
+    }
 
-                if (x >= 2 && x < MAP_WIDTH - 2 && y >= 2 && y < MAP_HEIGHT - 2) {
-                    // 60% chance để tạo tường trong cụm
-                    if (rand() % 100 < 60) {
-                        tiles[x][y].type = TileType::WALL;
-                        tiles[x][y].isPassable = false;
-                        tiles[x][y].shape.setTexture(&wallTexture); // Set wall texture
-                    }
-                }
-            }
+    // Copy into the chunk-major tile array (padding outside the map stays WALL)
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            tileData[tileIndex(x, y)] = Tile(generator.getTile(x, y));
         }
     }
-}
-
-void Map::createDoors() {
-    // Tạo cửa ở giữa các tường (hiện tại chỉ là placeholder)
-    // Có thể mở rộng sau để chuyển room
-}
+    invalidateAllRenderChunks();
 
-void Map::setSpawnPoints() {
-    // Find a safe spawn point for player near center
-    sf::Vector2f centerPoint(MAP_WIDTH * TILE_SIZE / 2, MAP_HEIGHT * TILE_SIZE / 2);
-    playerSpawnPoint = findSafeSpawnPoint(centerPoint, 100.0f); // Search within 100 pixels of center
+    DungeonGenerator::TilePos start = generator.getStart();
+    playerSpawnPoint = tileToWorld(sf::Vector2i(start.x, start.y));
 
-    // Enemy spawn points - rải rác khắp thế giới
     enemySpawnPoints.clear();
-
-    // Tạo nhiều spawn points hơn cho thế giới lớn
-    for (int i = 0; i < 50; i++) {
-        sf::Vector2f spawnPoint;
-        bool validSpawn = false;
-        int attempts = 0;
-
-        while (!validSpawn && attempts < 100) {
-            // Generate random position within map bounds (avoid edges)
-            spawnPoint.x = (2 + rand() % (MAP_WIDTH - 4)) * TILE_SIZE + TILE_SIZE/2;
-            spawnPoint.y = (2 + rand() % (MAP_HEIGHT - 4)) * TILE_SIZE + TILE_SIZE/2;
-
-            // Kiểm tra xem spawn point có hợp lệ không (không trên tường)
-            if (isPassable(spawnPoint)) {
-                // Đảm bảo không spawn quá gần player
-                float distanceToPlayer = std::sqrt(
-                    (spawnPoint.x - playerSpawnPoint.x) * (spawnPoint.x - playerSpawnPoint.x) +
-                    (spawnPoint.y - playerSpawnPoint.y) * (spawnPoint.y - playerSpawnPoint.y)
-                );
-
-                if (distanceToPlayer > 200.0f) { // Tối thiểu 200 pixels từ player
-                    validSpawn = true;
-                }
-            }
-            attempts++;
-        }
-
-        if (validSpawn) {
-            enemySpawnPoints.push_back(spawnPoint);
-        }
+    enemySpawnPoints.reserve(generator.getSpawnTiles().size());
+    for (const auto& spawn : generator.getSpawnTiles()) {
+        enemySpawnPoints.push_back(tileToWorld(sf::Vector2i(spawn.x, spawn.y)));
     }
 
-    std::cout << "Generated " << enemySpawnPoints.size() << " valid enemy spawn points" << std::endl;
+    std::cout << "Generated dungeon: " << generator.getRooms().size() << " rooms, "
+              << generator.getDoorCount() << " door tiles, " << generator.getReachableCount()
+              << " reachable tiles (" << generator.getSealedCount() << " sealed), "
+              << enemySpawnPoints.size() << " enemy spawn points in "
+              << generationTimer.getElapsedTime().asMilliseconds() << " ms" << std::endl;
 }
 
 sf::Vector2f Map::findSafeSpawnPoint(sf::Vector2f preferredPoint, float searchRadius) {
@@ -151,8 +156,8 @@ sf::Vector2f Map::findSafeSpawnPoint(sf::Vector2f preferredPoint, float searchRa
             );
 
             // Make sure point is within map bounds
-            if (testPoint.x >= TILE_SIZE && testPoint.x < (MAP_WIDTH - 1) * TILE_SIZE &&
-                testPoint.y >= TILE_SIZE && testPoint.y < (MAP_HEIGHT - 1) * TILE_SIZE) {
+            if (testPoint.x >= TILE_SIZE && testPoint.x < (width - 1) * TILE_SIZE &&
+                testPoint.y >= TILE_SIZE && testPoint.y < (height - 1) * TILE_SIZE) {
 
                 if (isPassable(testPoint)) {
                     std::cout << "Found safe spawn point at: " << testPoint.x << ", " << testPoint.y << std::endl;
@@ -164,8 +169,8 @@ sf::Vector2f Map::findSafeSpawnPoint(sf::Vector2f preferredPoint, float searchRa
 
     // Fallback: find any passable tile in the map
     std::cout << "Warning: Could not find safe spawn near preferred point, searching entire map..." << std::endl;
-    for (int x = 2; x < MAP_WIDTH - 2; x++) {
-        for (int y = 2; y < MAP_HEIGHT - 2; y++) {
+    for (int x = 2; x < width - 2; x++) {
+        for (int y = 2; y < height - 2; y++) {
             sf::Vector2f testPoint = tileToWorld(sf::Vector2i(x, y));
             if (isPassable(testPoint)) {
                 std::cout << "Fallback spawn point found at: " << testPoint.x << ", " << testPoint.y << std::endl;
@@ -181,42 +186,286 @@ sf::Vector2f Map::findSafeSpawnPoint(sf::Vector2f preferredPoint, float searchRa
 
 void Map::draw(sf::RenderWindow& window) {
     // Legacy function - draws all tiles (not recommended for large maps)
-    for (int x = 0; x < MAP_WIDTH; x++) {
-        for (int y = 0; y < MAP_HEIGHT; y++) {
-            window.draw(tiles[x][y].shape);
-        }
-    }
+    drawTileRange(window, 0, 0, width - 1, height - 1);
 }
 
 void Map::drawInView(sf::RenderWindow& window, sf::Vector2f cameraCenter, sf::Vector2f viewSize) {
     // Calculate visible tile range
     int startX = std::max(0, static_cast<int>((cameraCenter.x - viewSize.x/2) / TILE_SIZE) - 1);
-    int endX = std::min(MAP_WIDTH - 1, static_cast<int>((cameraCenter.x + viewSize.x/2) / TILE_SIZE) + 1);
+    int endX = std::min(width - 1, static_cast<int>((cameraCenter.x + viewSize.x/2) / TILE_SIZE) + 1);
     int startY = std::max(0, static_cast<int>((cameraCenter.y - viewSize.y/2) / TILE_SIZE) - 1);
-    int endY = std::min(MAP_HEIGHT - 1, static_cast<int>((cameraCenter.y + viewSize.y/2) / TILE_SIZE) + 1);
+    int endY = std::min(height - 1, static_cast<int>((cameraCenter.y + viewSize.y/2) / TILE_SIZE) + 1);
+
+    // Only draw chunks that are visible
+    drawTileRange(window, startX, startY, endX, endY);
+}
 
-    // Only draw tiles that are visible
-    for (int x = startX; x <= endX; x++) {
-        for (int y = startY; y <= endY; y++) {
-            window.draw(tiles[x][y].shape);
+void Map::drawTileRange(sf::RenderWindow& window, int startX, int startY, int endX, int endY) {
+    if (endX < startX || endY < startY) return;
+
+    renderFrame++;
+
+    // Two draw calls per visible chunk instead of one per tile
+    for (int chunkY = startY >> WorldChunk::SHIFT; chunkY <= endY >> WorldChunk::SHIFT; chunkY++) {
+        for (int chunkX = startX >> WorldChunk::SHIFT; chunkX <= endX >> WorldChunk::SHIFT; chunkX++) {
+            RenderChunk& chunk = getRenderChunk(chunkX, chunkY);
+            if (chunk.floorVertices.getVertexCount() > 0) {
+                window.draw(chunk.floorVertices, sf::RenderStates(floorTexture));
+            }
+            if (chunk.wallVertices.getVertexCount() > 0) {
+                window.draw(chunk.wallVertices, sf::RenderStates(wallTexture));
+            }
         }
     }
 }
 
+Map::RenderChunk& Map::getRenderChunk(int chunkX, int chunkY) {
+    // Small LRU cache - a view only ever touches a handful of chunks
+    RenderChunk* victim = &renderChunks[0];
+    for (auto& chunk : renderChunks) {
+        if (chunk.lastUsedFrame != 0 && chunk.chunkX == chunkX && chunk.chunkY == chunkY) {
+            // A streamed chunk that was (re)loaded since the build needs new vertices
+            if (chunk.sourceSerial != getChunkSerial(chunkX, chunkY)) {
+                buildRenderChunk(chunk, chunkX, chunkY);
+            }
+            chunk.lastUsedFrame = renderFrame;
+            return chunk;
+        }
+        if (chunk.lastUsedFrame < victim->lastUsedFrame) {
+            victim = &chunk;
+        }
+    }
+
+    buildRenderChunk(*victim, chunkX, chunkY);
+    return *victim;
+}
+
+void Map::buildRenderChunk(RenderChunk& chunk, int chunkX, int chunkY) {
+    chunk.chunkX = chunkX;
+    chunk.chunkY = chunkY;
+    chunk.lastUsedFrame = renderFrame;
+    chunk.sourceSerial = getChunkSerial(chunkX, chunkY);
+    chunk.floorVertices.clear(); // clear() keeps capacity, rebuilding does not reallocate
+    chunk.wallVertices.clear();
+
+    int startX = chunkX * WorldChunk::SIZE;
+    int startY = chunkY * WorldChunk::SIZE;
+    int endX = std::min(width, startX + WorldChunk::SIZE);
+    int endY = std::min(height, startY + WorldChunk::SIZE);
+
+    for (int y = startY; y < endY; y++) {
+        for (int x = startX; x < endX; x++) {
+            TileType type = getTile(x, y).getType();
+            bool isWall = type == TileType::WALL;
+            sf::VertexArray& vertices = isWall ? chunk.wallVertices : chunk.floorVertices;
+            const sf::FloatRect& tex = isWall ? wallTextureRect : floorTextureRect;
+            sf::Color tint = type == TileType::DOOR ? sf::Color(190, 140, 90) : sf::Color::White; // cửa: sàn tô màu gỗ
+
+            // Whole texture (or atlas entry) stretched over the tile, like the old per-tile RectangleShape
+            float left = static_cast<float>(x * TILE_SIZE);
+            float top = static_cast<float>(y * TILE_SIZE);
+            float size = static_cast<float>(TILE_SIZE);
+            float texRight = tex.left + tex.width;
+            float texBottom = tex.top + tex.height;
+            vertices.append(sf::Vertex(sf::Vector2f(left, top), tint, sf::Vector2f(tex.left, tex.top)));
+            vertices.append(sf::Vertex(sf::Vector2f(left + size, top), tint, sf::Vector2f(texRight, tex.top)));
+            vertices.append(sf::Vertex(sf::Vector2f(left + size, top + size), tint, sf::Vector2f(texRight, texBottom)));
+            vertices.append(sf::Vertex(sf::Vector2f(left, top + size), tint, sf::Vector2f(tex.left, texBottom)));
+        }
+    }
+}
+
+void Map::invalidateRenderChunk(int tileX, int tileY) {
+    int chunkX = tileX >> WorldChunk::SHIFT;
+    int chunkY = tileY >> WorldChunk::SHIFT;
+    tileRevision++;
+    for (auto& chunk : renderChunks) {
+        if (chunk.chunkX == chunkX && chunk.chunkY == chunkY) {
+            chunk.lastUsedFrame = 0;
+        }
+    }
+}
+
+void Map::invalidateAllRenderChunks() {
+    tileRevision++;
+    for (auto& chunk : renderChunks) {
+        chunk.lastUsedFrame = 0;
+    }
+}
+
+void Map::setTile(int tileX, int tileY, TileType type) {
+    if (!isInBounds(tileX, tileY)) return;
+
+    if (streamer) {
+        WorldChunk* chunk = streamer->getMutableChunk(tileX >> WorldChunk::SHIFT, tileY >> WorldChunk::SHIFT);
+        if (!chunk) return; // not loaded
+        chunk->setTile(tileX & WorldChunk::MASK, tileY & WorldChunk::MASK, type);
+    } else {
+        tileData[tileIndex(tileX, tileY)] = Tile(type); // mapped pages are copy-on-write
+    }
+    invalidateRenderChunk(tileX, tileY);
+}
+
+void Map::updateStreaming(sf::Vector2f focus) {
+    if (!streamer) return;
+
+    sf::Vector2i focusTile = worldToTile(focus);
+    int focusChunkX = std::max(0, std::min(chunksX - 1, focusTile.x >> WorldChunk::SHIFT));
+    int focusChunkY = std::max(0, std::min(chunksY - 1, focusTile.y >> WorldChunk::SHIFT));
+
+    if (streamer->update(focusChunkX, focusChunkY)) {
+        tileRevision++; // chunks were loaded or evicted
+        rebuildStreamedSpawnPoints();
+    }
+}
+
+void Map::generateChunk(int chunkX, int chunkY, WorldChunk& chunk) const {
+    // Cut from the chunk's sector. Prefetch and saving generate chunks on the
+    // main thread, so the sector cache is shared and locked.
+    std::lock_guard<std::mutex> lock(sectorMutex);
+    const Sector& sector = getSector(std::min(chunkX / SECTOR_CHUNKS, sectorsX - 1),
+                                     std::min(chunkY / SECTOR_CHUNKS, sectorsY - 1));
+    int originX = chunkX * WorldChunk::SIZE;
+    int originY = chunkY * WorldChunk::SIZE;
+
+    chunk.fill(TileType::WALL); // padding outside the map stays WALL
+    for (int ly = 0; ly < WorldChunk::SIZE; ly++) {
+        int y = originY + ly - sector.originY;
+        if (y >= sector.height) break;
+        for (int lx = 0; lx < WorldChunk::SIZE; lx++) {
+            int x = originX + lx - sector.originX;
+            if (x >= sector.width) break;
+            chunk.setTile(lx, ly, sector.tiles[y * sector.width + x]);
+        }
+    }
+
+    // Enemy spawns from the sector's reachable set
+    for (const auto& spawn : sector.spawnTiles) {
+        int lx = spawn.x - originX;
+        int ly = spawn.y - originY;
+        if (lx < 0 || ly < 0 || lx >= WorldChunk::SIZE || ly >= WorldChunk::SIZE) continue;
+        chunk.spawnTiles[chunk.spawnCount++] = static_cast<std::uint16_t>((ly << WorldChunk::SHIFT) | lx);
+        if (chunk.spawnCount == WorldChunk::MAX_SPAWNS) break;
+    }
+}
+
+const Map::Sector& Map::getSector(int sectorX, int sectorY) const {
+    // Small LRU cache: the streamed area around the player spans at most 4 sectors
+    Sector* victim = &sectorCache[0];
+    for (Sector& sector : sectorCache) {
+        if (sector.sectorX == sectorX && sector.sectorY == sectorY) {
+            sector.lastUsed = ++sectorUseCounter;
+            return sector;
+        }
+        if (sector.lastUsed < victim->lastUsed) {
+            victim = &sector;
+        }
+    }
+
+    generateSector(*victim, sectorX, sectorY);
+    victim->lastUsed = ++sectorUseCounter;
+    return *victim;
+}
+
+void Map::generateSector(Sector& sector, int sectorX, int sectorY) const {
+    sector.sectorX = sectorX;
+    sector.sectorY = sectorY;
+    sector.originX = sectorX * SECTOR_TILES;
+    sector.originY = sectorY * SECTOR_TILES;
+    sector.width = (sectorX == sectorsX - 1 ? width : sector.originX + SECTOR_TILES) - sector.originX;
+    sector.height = (sectorY == sectorsY - 1 ? height : sector.originY + SECTOR_TILES) - sector.originY;
+
+    DungeonSettings settings;
+    settings.spawnCount = sector.width * sector.height / 300; // ~3 per chunk; chunks keep up to MAX_SPAWNS
+    settings.minSpawnDistance = 200 / TILE_SIZE + 1;          // Tối thiểu 200 pixels từ player
+    settings.threads = 1;                                     // already off the main thread
+
+    // Deterministic per sector, so an evicted chunk comes back identical
+    unsigned int sectorSeed = seed ^ (static_cast<unsigned int>(sectorX) * 73856093u)
+                                   ^ (static_cast<unsigned int>(sectorY) * 19349663u);
+    DungeonGenerator generator(sector.width, sector.height, sectorSeed, settings);
+
+    // One gate per shared border, at an offset both sides derive from the border alone
+    if (sectorX > 0) {
+        generator.addExit(0, getGateOffset(sectorX - 1, sectorY, true, sector.height));
+    }
+    if (sectorX < sectorsX - 1) {
+        generator.addExit(sector.width - 1, getGateOffset(sectorX, sectorY, true, sector.height));
+    }
+    if (sectorY > 0) {
+        generator.addExit(getGateOffset(sectorX, sectorY - 1, false, sector.width), 0);
+    }
+    if (sectorY < sectorsY - 1) {
+        generator.addExit(getGateOffset(sectorX, sectorY, false, sector.width), sector.height - 1);
+    }
+    sector.valid = generator.generate();
+
+    sector.tiles.resize(static_cast<std::size_t>(sector.width) * sector.height);
+    for (int y = 0; y < sector.height; y++) {
+        for (int x = 0; x < sector.width; x++) {
+            sector.tiles[y * sector.width + x] = generator.getTile(x, y);
+        }
+    }
+    sector.spawnTiles.clear();
+    for (const auto& spawn : generator.getSpawnTiles()) {
+        sector.spawnTiles.push_back({sector.originX + spawn.x, sector.originY + spawn.y});
+    }
+    sector.start = {sector.originX + generator.getStart().x, sector.originY + generator.getStart().y};
+}
+
+int Map::getGateOffset(int sectorX, int sectorY, bool eastBorder, int borderLength) const {
+    // The gate in the east (or south) border of a sector, as an offset along that border
+    std::minstd_rand rng(seed ^ (static_cast<unsigned int>(sectorX) * 83492791u)
+                              ^ (static_cast<unsigned int>(sectorY) * 2654435761u) ^ (eastBorder ? 0x9E3779B9u : 0u));
+    int span = borderLength - 2 * GATE_MARGIN - DungeonSettings().corridorWidth;
+    return GATE_MARGIN + (span > 0 ? static_cast<int>(rng() % static_cast<unsigned int>(span)) : 0);
+}
+
+void Map::rebuildStreamedSpawnPoints() {
+    // Capacity was reserved for a full streamer budget, so this never allocates
+    enemySpawnPoints.clear();
+    streamer->forEachResidentChunk([this](int chunkX, int chunkY, const WorldChunk& chunk) {
+        for (int i = 0; i < chunk.spawnCount; i++) {
+            int lx = chunk.spawnTiles[i] & WorldChunk::MASK;
+            int ly = chunk.spawnTiles[i] >> WorldChunk::SHIFT;
+            enemySpawnPoints.push_back(tileToWorld(sf::Vector2i(chunkX * WorldChunk::SIZE + lx,
+                                                                chunkY * WorldChunk::SIZE + ly)));
+        }
+    });
+}
+
+std::size_t Map::getTileMemoryBytes() const {
+    if (streamer) return streamer->getMemoryBytes();
+    if (mappedFile) return mappedFile->getSize(); // page cache, not heap
+    return tiles.capacity() * sizeof(Tile);
+}
+
+int Map::countBlockedNeighbours(int tileX, int tileY) const {
+    int count = 0;
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            if ((dx != 0 || dy != 0) && !isPassableTile(tileX + dx, tileY + dy)) {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
 bool Map::isPassable(float x, float y) const {
     return isPassable(sf::Vector2f(x, y));
 }
 
 bool Map::isPassable(sf::Vector2f position) const {
-    sf::Vector2i tilePos = worldToTile(position);
-
-    // Kiểm tra bounds - với tường bao, không thể đi ra ngoài map
-    if (tilePos.x < 0 || tilePos.x >= MAP_WIDTH ||
-        tilePos.y < 0 || tilePos.y >= MAP_HEIGHT) {
+    // Negative coordinates must not truncate towards tile 0
+    if (position.x < 0.f || position.y < 0.f) {
         return false; // Không thể đi ra ngoài map có tường bao
     }
 
-    return tiles[tilePos.x][tilePos.y].isPassable;
+    sf::Vector2i tilePos = worldToTile(position);
+
+    // Out-of-bounds tiles read as walls - với tường bao, không thể đi ra ngoài map
+    return isPassableTile(tilePos.x, tilePos.y);
 }
 
 sf::Vector2i Map::worldToTile(sf::Vector2f worldPos) const {
@@ -233,3 +482,252 @@ sf::Vector2f Map::tileToWorld(sf::Vector2i tilePos) const {
     );
 }
 
+
+void Map::readChunk(int chunkX, int chunkY, WorldChunk& chunk) const {
+    if (streamer) {
+        const WorldChunk* resident = streamer->getChunk(chunkX, chunkY);
+        if (resident) {
+            chunk = *resident; // keeps edits made since it was loaded
+        } else {
+            generateChunk(chunkX, chunkY, chunk);
+        }
+        return;
+    }
+
+    int chunk0 = (chunkY * chunksX + chunkX) * WorldChunk::TILE_COUNT;
+    std::copy(tileData + chunk0, tileData + chunk0 + WorldChunk::TILE_COUNT, chunk.tiles);
+    chunk.spawnCount = 0; // resident spawn points are not limited to MAX_SPAWNS per chunk
+}
+
+void Map::detachMappedFile() {
+    if (!mappedFile) return;
+    tiles.assign(tileData, tileData + static_cast<std::size_t>(chunksX) * chunksY * WorldChunk::TILE_COUNT);
+    tileData = tiles.data();
+    mappedFile.reset();
+}
+
+bool Map::saveToFile(const std::string& path) {
+    // Offline only (bakes a world into a file): readChunk() below generates any chunk a
+    // streamed map hasn't loaded, so a streamed world is generated whole, right here.
+    // Write to a temporary file first: the target may be the file this map is mapped from
+    std::string tempPath = path + ".tmp";
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Could not open " << tempPath << " for writing" << std::endl;
+        return false;
+    }
+
+    std::uint32_t chunkCount = static_cast<std::uint32_t>(chunksX * chunksY);
+
+    MapFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAP_FILE_MAGIC, sizeof(header.magic));
+    header.version = MAP_FILE_VERSION;
+    header.flags = MAP_TILED_LAYOUT ? MAP_FILE_FLAG_TILED_LAYOUT : 0;
+    header.width = static_cast<std::uint32_t>(width);
+    header.height = static_cast<std::uint32_t>(height);
+    header.chunkSize = WorldChunk::SIZE;
+    header.chunksX = static_cast<std::uint32_t>(chunksX);
+    header.chunksY = static_cast<std::uint32_t>(chunksY);
+    header.playerSpawnX = playerSpawnPoint.x;
+    header.playerSpawnY = playerSpawnPoint.y;
+    header.chunkIndexOffset = sizeof(MapFileHeader);
+    std::uint64_t indexEnd = header.chunkIndexOffset + chunkCount * sizeof(MapFileChunkEntry);
+    header.tileLayerOffset = (indexEnd + MAP_FILE_TILE_ALIGNMENT - 1) / MAP_FILE_TILE_ALIGNMENT * MAP_FILE_TILE_ALIGNMENT;
+    header.spawnTableOffset = header.tileLayerOffset + static_cast<std::uint64_t>(chunkCount) * WorldChunk::TILE_COUNT;
+
+    // Spawn table grouped by chunk
+    std::vector<MapFileChunkEntry> entries(chunkCount);
+    std::vector<MapFileSpawn> spawns;
+    if (!streamer) {
+        for (const auto& point : enemySpawnPoints) {
+            sf::Vector2i tile = worldToTile(point);
+            if (isInBounds(tile.x, tile.y)) {
+                spawns.push_back({static_cast<std::uint32_t>(tile.x), static_cast<std::uint32_t>(tile.y)});
+            }
+        }
+        std::stable_sort(spawns.begin(), spawns.end(), [](const MapFileSpawn& a, const MapFileSpawn& b) {
+            std::uint32_t chunkA = (a.tileY >> WorldChunk::SHIFT) << 16 | (a.tileX >> WorldChunk::SHIFT);
+            std::uint32_t chunkB = (b.tileY >> WorldChunk::SHIFT) << 16 | (b.tileX >> WorldChunk::SHIFT);
+            return chunkA < chunkB;
+        });
+    }
+
+    // Header and index are rewritten once the spawn table is known
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(MapFileChunkEntry));
+    std::vector<char> padding(static_cast<std::size_t>(header.tileLayerOffset - indexEnd), 0);
+    file.write(padding.data(), padding.size());
+
+    // Tile layer
+    WorldChunk chunk;
+    std::size_t nextResidentSpawn = 0;
+    for (int chunkY = 0; chunkY < chunksY; chunkY++) {
+        for (int chunkX = 0; chunkX < chunksX; chunkX++) {
+            std::uint32_t i = static_cast<std::uint32_t>(chunkY * chunksX + chunkX);
+            readChunk(chunkX, chunkY, chunk);
+            file.write(reinterpret_cast<const char*>(chunk.tiles), sizeof(chunk.tiles));
+
+            MapFileChunkEntry& entry = entries[i];
+            entry.tileOffset = header.tileLayerOffset + static_cast<std::uint64_t>(i) * WorldChunk::TILE_COUNT;
+            if (streamer) {
+                entry.firstSpawn = static_cast<std::uint32_t>(spawns.size());
+                for (int s = 0; s < chunk.spawnCount; s++) {
+                    spawns.push_back({static_cast<std::uint32_t>(chunkX * WorldChunk::SIZE + (chunk.spawnTiles[s] & WorldChunk::MASK)),
+                                      static_cast<std::uint32_t>(chunkY * WorldChunk::SIZE + (chunk.spawnTiles[s] >> WorldChunk::SHIFT))});
+                }
+                entry.spawnCount = static_cast<std::uint16_t>(chunk.spawnCount);
+            } else {
+                entry.firstSpawn = static_cast<std::uint32_t>(nextResidentSpawn);
+                while (nextResidentSpawn < spawns.size() &&
+                       static_cast<int>(spawns[nextResidentSpawn].tileX >> WorldChunk::SHIFT) == chunkX &&
+                       static_cast<int>(spawns[nextResidentSpawn].tileY >> WorldChunk::SHIFT) == chunkY) {
+                    nextResidentSpawn++;
+                }
+                entry.spawnCount = static_cast<std::uint16_t>(nextResidentSpawn - entry.firstSpawn);
+            }
+        }
+    }
+
+    // Spawn table, then the final header and index
+    header.spawnCount = static_cast<std::uint32_t>(spawns.size());
+    file.write(reinterpret_cast<const char*>(spawns.data()), spawns.size() * sizeof(MapFileSpawn));
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(MapFileChunkEntry));
+    file.close();
+
+    if (!file) {
+        std::cerr << "Failed writing map file " << tempPath << std::endl;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+#ifdef _WIN32
+    // A mapped file can't be replaced (or deleted) on Windows, and the target may be ours
+    detachMappedFile();
+#endif
+    if (!MappedFile::replaceFile(tempPath, path)) {
+        std::cerr << "Could not replace " << path << std::endl;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    std::cout << "Saved map " << width << "x" << height << " (" << spawns.size()
+              << " spawn points) to " << path << std::endl;
+    return true;
+}
+
+bool Map::loadFromFile(const std::string& path) {
+    auto file = std::make_unique<MappedFile>();
+    if (!file->open(path)) {
+        std::cerr << "Could not open map file " << path << std::endl;
+        return false;
+    }
+
+    // Validate everything before touching the current map
+    const unsigned char* data = file->getData();
+    std::uint64_t size = file->getSize();
+    MapFileHeader header;
+    if (size < sizeof(header)) {
+        std::cerr << "Map file " << path << " is truncated" << std::endl;
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+
+    if (std::memcmp(header.magic, MAP_FILE_MAGIC, sizeof(header.magic)) != 0 || header.version != MAP_FILE_VERSION) {
+        std::cerr << "Map file " << path << " has an unsupported format or version" << std::endl;
+        return false;
+    }
+
+    // Offsets are untrusted: contains() checks ranges without overflowing. The
+    // dimension checks come first, so chunkCount is small by the time it's used.
+    std::uint64_t chunkCount = static_cast<std::uint64_t>(header.chunksX) * header.chunksY;
+    if (header.chunkSize != WorldChunk::SIZE || header.width == 0 || header.height == 0 ||
+        header.width > MAX_FILE_DIMENSION || header.height > MAX_FILE_DIMENSION ||
+        header.chunksX != (header.width + WorldChunk::SIZE - 1) / WorldChunk::SIZE ||
+        header.chunksY != (header.height + WorldChunk::SIZE - 1) / WorldChunk::SIZE ||
+        !file->contains(header.chunkIndexOffset, chunkCount * sizeof(MapFileChunkEntry)) ||
+        !file->contains(header.spawnTableOffset, static_cast<std::uint64_t>(header.spawnCount) * sizeof(MapFileSpawn))) {
+        std::cerr << "Map file " << path << " is corrupt" << std::endl;
+        return false;
+    }
+
+    // The tile layer can be used in place if it is contiguous and in this build's layout
+    bool sameLayout = ((header.flags & MAP_FILE_FLAG_TILED_LAYOUT) != 0) == (MAP_TILED_LAYOUT != 0);
+    bool contiguous = true;
+    for (std::uint64_t i = 0; i < chunkCount; i++) {
+        MapFileChunkEntry entry;
+        std::memcpy(&entry, data + header.chunkIndexOffset + i * sizeof(MapFileChunkEntry), sizeof(entry));
+        if (!file->contains(entry.tileOffset, WorldChunk::TILE_COUNT) ||
+            static_cast<std::uint64_t>(entry.firstSpawn) + entry.spawnCount > header.spawnCount) {
+            std::cerr << "Map file " << path << " has a bad chunk index" << std::endl;
+            return false;
+        }
+        contiguous = contiguous && entry.tileOffset == header.tileLayerOffset + i * WorldChunk::TILE_COUNT;
+    }
+
+    // Commit: replace the current map
+    streamer.reset();
+    width = static_cast<int>(header.width);
+    height = static_cast<int>(header.height);
+    chunksX = static_cast<int>(header.chunksX);
+    chunksY = static_cast<int>(header.chunksY);
+
+    if (sameLayout && contiguous) {
+        tiles.clear();
+        tiles.shrink_to_fit();
+        tileData = reinterpret_cast<Tile*>(file->getMutableData() + header.tileLayerOffset);
+        mappedFile = std::move(file);
+    } else {
+        // Fallback: copy into the tile array, converting the in-chunk order
+        tiles.assign(static_cast<std::size_t>(chunkCount) * WorldChunk::TILE_COUNT, Tile(TileType::WALL));
+        tileData = tiles.data();
+        bool fileTiled = (header.flags & MAP_FILE_FLAG_TILED_LAYOUT) != 0;
+        for (std::uint64_t i = 0; i < chunkCount; i++) {
+            MapFileChunkEntry entry;
+            std::memcpy(&entry, data + header.chunkIndexOffset + i * sizeof(MapFileChunkEntry), sizeof(entry));
+            const unsigned char* source = data + entry.tileOffset;
+            for (int ly = 0; ly < WorldChunk::SIZE; ly++) {
+                for (int lx = 0; lx < WorldChunk::SIZE; lx++) {
+                    int from = fileTiled ? WorldChunk::tiledIndex(lx, ly) : WorldChunk::rowMajorIndex(lx, ly);
+                    tiles[i * WorldChunk::TILE_COUNT + WorldChunk::tileIndex(lx, ly)].bits = source[from];
+                }
+            }
+        }
+        mappedFile.reset();
+        std::cout << "Map file " << path << " uses a different tile layout, tiles were copied" << std::endl;
+    }
+
+    // Spawn table: enemies must not start inside a wall or off the map
+    enemySpawnPoints.clear();
+    enemySpawnPoints.reserve(header.spawnCount);
+    std::uint32_t rejectedSpawns = 0;
+    for (std::uint32_t i = 0; i < header.spawnCount; i++) {
+        MapFileSpawn spawn;
+        std::memcpy(&spawn, data + header.spawnTableOffset + i * sizeof(MapFileSpawn), sizeof(spawn));
+        if (spawn.tileX >= header.width || spawn.tileY >= header.height ||
+            !isPassableTile(static_cast<int>(spawn.tileX), static_cast<int>(spawn.tileY))) {
+            rejectedSpawns++;
+            continue;
+        }
+        enemySpawnPoints.push_back(tileToWorld(sf::Vector2i(spawn.tileX, spawn.tileY)));
+    }
+    if (rejectedSpawns > 0) {
+        std::cerr << "Map file " << path << ": ignored " << rejectedSpawns
+                  << " spawn point(s) on a wall or outside the map" << std::endl;
+    }
+
+    // The player spawn is a world position; NaN or far outside the map starts from the centre
+    sf::Vector2f playerSpawn(header.playerSpawnX, header.playerSpawnY);
+    if (!isWithinWorld(playerSpawn)) {
+        std::cerr << "Map file " << path << ": player spawn is outside the map" << std::endl;
+        playerSpawn = sf::Vector2f(width * TILE_SIZE / 2.0f, height * TILE_SIZE / 2.0f);
+    }
+    playerSpawnPoint = findSafeSpawnPoint(playerSpawn, 100.0f);
+    invalidateAllRenderChunks();
+
+    std::cout << "Loaded map " << width << "x" << height << " from " << path << " ("
+              << enemySpawnPoints.size() << " spawn points)" << std::endl;
+    return true;
+}
@@ -0,0 +1,84 @@
+#include "../include/MemoryBudget.h"
+
+std::size_t MemoryBudget::usage[MemoryBudget::CATEGORY_COUNT] = {};
+std::size_t MemoryBudget::peak[MemoryBudget::CATEGORY_COUNT] = {};
+std::size_t MemoryBudget::peakTotal = 0;
+std::size_t MemoryBudget::budget = 0;
+unsigned int MemoryBudget::evictionCount = 0;
+
+void MemoryBudget::add(MemoryCategory category, std::size_t bytes) {
+    int index = static_cast<int>(category);
+    usage[index] += bytes;
+    if (usage[index] > peak[index]) peak[index] = usage[index];
+
+    std::size_t total = getTotal();
+    if (total > peakTotal) peakTotal = total;
+}
+
+void MemoryBudget::remove(MemoryCategory category, std::size_t bytes) {
+    int index = static_cast<int>(category);
+    usage[index] -= bytes < usage[index] ? bytes : usage[index];
+}
+
+std::size_t MemoryBudget::getTotal() {
+    std::size_t total = 0;
+    for (std::size_t bytes : usage) {
+        total += bytes;
+    }
+    return total;
+}
+
+bool MemoryBudget::exceeds(std::size_t extraBytes) {
+    return budget > 0 && getTotal() + extraBytes > budget;
+}
+
+std::size_t MemoryBudget::bytesOf(const sf::Texture& texture) {
+    sf::Vector2u size = texture.getSize();
+    return static_cast<std::size_t>(size.x) * size.y * 4;
+}
+
+std::size_t MemoryBudget::bytesOf(const sf::SoundBuffer& sound) {
+    return static_cast<std::size_t>(sound.getSampleCount()) * sizeof(sf::Int16);
+}
+
+void MemoryBudget::report(std::ostream& out) {
+    static const char* const NAMES[CATEGORY_COUNT] = {"textures", "render textures", "sound buffers"};
+    const double MB = 1024.0 * 1024.0;
+
+    out << "Memory (current / peak MB):" << std::endl;
+    for (int i = 0; i < CATEGORY_COUNT; i++) {
+        out << "  " << NAMES[i] << ": " << usage[i] / MB << " / " << peak[i] / MB << std::endl;
+    }
+    out << "  total: " << getTotal() / MB << " / " << peakTotal / MB;
+    if (budget > 0) {
+        out << ", budget " << budget / MB << ", " << evictionCount << " evictions";
+    }
+    out << std::endl;
+}
+
+MemoryCharge::MemoryCharge(MemoryCategory chargeCategory) : category(chargeCategory), bytes(0) {
+}
+
+MemoryCharge::MemoryCharge(const MemoryCharge& other) : category(other.category), bytes(other.bytes) {
+    MemoryBudget::add(category, bytes);
+}
+
+MemoryCharge& MemoryCharge::operator=(const MemoryCharge& other) {
+    if (this != &other) {
+        MemoryBudget::remove(category, bytes);
+        category = other.category;
+        bytes = other.bytes;
+        MemoryBudget::add(category, bytes);
+    }
+    return *this;
+}
+
+MemoryCharge::~MemoryCharge() {
+    MemoryBudget::remove(category, bytes);
+}
+
+void MemoryCharge::set(std::size_t newBytes) {
+    MemoryBudget::remove(category, bytes);
+    bytes = newBytes;
+    MemoryBudget::add(category, bytes);
+}
@@ -0,0 +1,118 @@
+#include "../include/Minimap.h"
+#include "../include/Map.h"
+#include <iostream>
+
+Minimap::Minimap(float screenX, float screenY, float screenSize)
+    : screenRect(screenX, screenY, screenSize, screenSize),
+      tileTextureCharge(MemoryCategory::RENDER_TEXTURE),
+      tilePixels(sf::Points, static_cast<std::size_t>(CACHE_TILES) * CACHE_TILES),
+      textureReady(false), cachedMap(nullptr), cachedRevision(0),
+      originX(0), originY(0), viewX(0), viewY(0), framesSinceRebuild(0), rebuildCount(0) {
+    // Point positions never change: pixel centres of the cached window
+    for (int y = 0; y < CACHE_TILES; y++) {
+        for (int x = 0; x < CACHE_TILES; x++) {
+            tilePixels[y * CACHE_TILES + x].position = sf::Vector2f(x + 0.5f, y + 0.5f);
+        }
+    }
+
+    tileSprite.setPosition(screenX, screenY);
+    tileSprite.setScale(screenSize / VIEW_TILES, screenSize / VIEW_TILES);
+
+    markers.setPrimitiveType(sf::Triangles);
+    markers.resize(static_cast<std::size_t>(MAX_MARKERS) * 6); // reserve the worst case once
+    markers.clear();
+}
+
+void Minimap::update(const Map& map, sf::Vector2f playerPosition) {
+    sf::Vector2i playerTile = map.worldToTile(playerPosition);
+    viewX = playerTile.x - VIEW_TILES / 2;
+    viewY = playerTile.y - VIEW_TILES / 2;
+    framesSinceRebuild++;
+
+    // Re-render when the shown area leaves the cached window (re-centring it),
+    // or when tiles changed - streamed maps change every time a chunk loads, so
+    // those rebuilds are spaced out by MIN_REBUILD_FRAMES
+    bool outside = viewX < originX || viewY < originY ||
+                   viewX + VIEW_TILES > originX + CACHE_TILES || viewY + VIEW_TILES > originY + CACHE_TILES;
+    bool tilesChanged = map.getTileRevision() != cachedRevision;
+    if (&map != cachedMap || outside || (tilesChanged && framesSinceRebuild >= MIN_REBUILD_FRAMES)) {
+        if (&map != cachedMap || outside) {
+            originX = viewX - (CACHE_TILES - VIEW_TILES) / 2;
+            originY = viewY - (CACHE_TILES - VIEW_TILES) / 2;
+        }
+        rebuild(map);
+    }
+
+    tileSprite.setTextureRect(sf::IntRect(viewX - originX, viewY - originY, VIEW_TILES, VIEW_TILES));
+}
+
+void Minimap::rebuild(const Map& map) {
+    if (cachedMap == nullptr) {
+        // First rebuild: needs the window's GL context, so not done in the constructor
+        textureReady = tileTexture.create(CACHE_TILES, CACHE_TILES);
+        if (textureReady) {
+            tileTextureCharge.set(tileTexture.getTexture());
+            tileSprite.setTexture(tileTexture.getTexture());
+        } else {
+            std::cerr << "Could not create the minimap texture" << std::endl;
+        }
+    }
+
+    cachedMap = &map;
+    cachedRevision = map.getTileRevision();
+    framesSinceRebuild = 0;
+    if (!textureReady) return;
+
+    for (int y = 0; y < CACHE_TILES; y++) {
+        for (int x = 0; x < CACHE_TILES; x++) {
+            int tileX = originX + x;
+            int tileY = originY + y;
+            sf::Color color = sf::Color::Transparent; // outside the map
+            if (map.isInBounds(tileX, tileY)) {
+                switch (map.getTile(tileX, tileY).getType()) {
+                    case TileType::WALL: color = sf::Color(40, 40, 50, 200); break;
+                    case TileType::DOOR: color = sf::Color(170, 110, 40, 220); break;
+                    default:             color = sf::Color(140, 130, 115, 200); break;
+                }
+            }
+            tilePixels[y * CACHE_TILES + x].color = color;
+        }
+    }
+
+    tileTexture.clear(sf::Color::Transparent);
+    tileTexture.draw(tilePixels);
+    tileTexture.display();
+    rebuildCount++;
+}
+
+void Minimap::addMarker(sf::Vector2f worldPosition, sf::Color color, float size) {
+    if (markers.getVertexCount() >= static_cast<std::size_t>(MAX_MARKERS) * 6) return;
+
+    // World -> minimap pixels, relative to the shown area
+    float scale = screenRect.width / (VIEW_TILES * Map::getTileSize());
+    float x = screenRect.left + (worldPosition.x - viewX * Map::getTileSize()) * scale;
+    float y = screenRect.top + (worldPosition.y - viewY * Map::getTileSize()) * scale;
+    float half = size * 0.5f;
+    if (x - half < screenRect.left || y - half < screenRect.top ||
+        x + half > screenRect.left + screenRect.width || y + half > screenRect.top + screenRect.height) {
+        return; // off the minimap
+    }
+
+    sf::Vector2f topLeft(x - half, y - half), topRight(x + half, y - half);
+    sf::Vector2f bottomLeft(x - half, y + half), bottomRight(x + half, y + half);
+    markers.append(sf::Vertex(topLeft, color));
+    markers.append(sf::Vertex(topRight, color));
+    markers.append(sf::Vertex(bottomRight, color));
+    markers.append(sf::Vertex(topLeft, color));
+    markers.append(sf::Vertex(bottomRight, color));
+    markers.append(sf::Vertex(bottomLeft, color));
+}
+
+void Minimap::draw(sf::RenderTarget& target) {
+    if (textureReady) {
+        target.draw(tileSprite);
+    }
+    if (markers.getVertexCount() > 0) {
+        target.draw(markers);
+    }
+}
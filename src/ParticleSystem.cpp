@@ -0,0 +1,136 @@
+#include "../include/ParticleSystem.h"
+#include <algorithm>
+#include <cmath>
+
+//                                              count speed      spread lifetime size damping color                      blend
+const ParticleBurst ParticleSystem::HIT_SPARK    = {10, 60.f, 180.f, 1.6f, 0.25f, 3.f, 0.05f, sf::Color(255, 230, 150), ParticleBlend::ADDITIVE};
+const ParticleBurst ParticleSystem::DEATH_BURST  = {40, 40.f, 160.f, 6.3f, 0.6f,  4.f, 0.10f, sf::Color(255, 255, 255), ParticleBlend::ALPHA};
+const ParticleBurst ParticleSystem::PLAYER_HIT   = {14, 50.f, 140.f, 6.3f, 0.35f, 3.f, 0.05f, sf::Color(220, 30, 30),   ParticleBlend::ALPHA};
+const ParticleBurst ParticleSystem::MUZZLE_FLASH = {8,  90.f, 220.f, 0.5f, 0.12f, 3.f, 0.02f, sf::Color(255, 200, 80),  ParticleBlend::ADDITIVE};
+const ParticleBurst ParticleSystem::MAGIC_SPARK  = {12, 30.f, 120.f, 1.2f, 0.3f,  3.f, 0.10f, sf::Color(140, 120, 255), ParticleBlend::ADDITIVE};
+const ParticleBurst ParticleSystem::SWORD_SWISH  = {6,  40.f, 90.f,  1.6f, 0.15f, 2.f, 0.05f, sf::Color(230, 240, 255), ParticleBlend::ADDITIVE};
+
+ParticleSystem::ParticleSystem(int capacity)
+    : capacity(capacity), count(0), rng(2024u) {
+    posX.resize(capacity);
+    posY.resize(capacity);
+    velX.resize(capacity);
+    velY.resize(capacity);
+    age.resize(capacity);
+    lifetime.resize(capacity);
+    particleSize.resize(capacity);
+    drag.resize(capacity);
+    color.resize(capacity);
+    blend.resize(capacity);
+
+    for (sf::VertexArray& array : vertices) {
+        array.setPrimitiveType(sf::Triangles);
+        array.resize(static_cast<std::size_t>(capacity) * 6); // reserve the worst case once
+        array.clear();
+    }
+}
+
+float ParticleSystem::randomRange(float minValue, float maxValue) {
+    return minValue + (maxValue - minValue) * (static_cast<float>(rng() - rng.min()) / static_cast<float>(rng.max() - rng.min()));
+}
+
+void ParticleSystem::emit(sf::Vector2f position, sf::Vector2f direction, const ParticleBurst& burst) {
+    emit(position, direction, burst, burst.color);
+}
+
+void ParticleSystem::emit(sf::Vector2f position, sf::Vector2f direction, const ParticleBurst& burst, sf::Color tint) {
+    float baseAngle = (direction.x == 0.f && direction.y == 0.f) ? 0.f : std::atan2(direction.y, direction.x);
+    int emitCount = std::min(burst.count, capacity - count);
+
+    for (int n = 0; n < emitCount; n++) {
+        int i = count++;
+        float angle = baseAngle + randomRange(-0.5f, 0.5f) * burst.spread;
+        float speed = randomRange(burst.speedMin, burst.speedMax);
+        posX[i] = position.x;
+        posY[i] = position.y;
+        velX[i] = std::cos(angle) * speed;
+        velY[i] = std::sin(angle) * speed;
+        age[i] = 0.f;
+        lifetime[i] = burst.lifetime * randomRange(0.75f, 1.25f);
+        particleSize[i] = burst.size;
+        drag[i] = -std::log(std::max(burst.damping, 0.0001f)); // so velocity *= damping per second
+        color[i] = tint;
+        blend[i] = burst.blend;
+    }
+}
+
+void ParticleSystem::update(float dt) {
+    // Integrate: straight loops over flat arrays
+    for (int i = 0; i < count; i++) {
+        float keep = std::max(0.f, 1.f - drag[i] * dt); // first-order damping^dt
+        velX[i] *= keep;
+        velY[i] *= keep;
+        posX[i] += velX[i] * dt;
+        posY[i] += velY[i] * dt;
+        age[i] += dt;
+    }
+
+    // Compact: move live particles down over dead ones (order doesn't matter)
+    int alive = 0;
+    for (int i = 0; i < count; i++) {
+        if (age[i] >= lifetime[i]) continue;
+        if (alive != i) {
+            posX[alive] = posX[i];
+            posY[alive] = posY[i];
+            velX[alive] = velX[i];
+            velY[alive] = velY[i];
+            age[alive] = age[i];
+            lifetime[alive] = lifetime[i];
+            particleSize[alive] = particleSize[i];
+            drag[alive] = drag[i];
+            color[alive] = color[i];
+            blend[alive] = blend[i];
+        }
+        alive++;
+    }
+    count = alive;
+}
+
+void ParticleSystem::draw(sf::RenderTarget& target, const sf::FloatRect& viewBounds) {
+    if (count == 0) return;
+
+    const int blendCount = static_cast<int>(ParticleBlend::COUNT);
+    std::size_t used[blendCount] = {};
+    for (sf::VertexArray& array : vertices) {
+        array.resize(static_cast<std::size_t>(count) * 6); // within the reserved capacity
+    }
+
+    float minX = viewBounds.left, maxX = viewBounds.left + viewBounds.width;
+    float minY = viewBounds.top, maxY = viewBounds.top + viewBounds.height;
+    for (int i = 0; i < count; i++) {
+        float x = posX[i];
+        float y = posY[i];
+        if (x < minX || x > maxX || y < minY || y > maxY) continue;
+
+        // Shrink and fade out over the lifetime
+        float remaining = 1.f - age[i] / lifetime[i];
+        float half = particleSize[i] * remaining * 0.5f + 0.5f;
+        sf::Color c = color[i];
+        c.a = static_cast<sf::Uint8>(c.a * remaining);
+
+        int b = static_cast<int>(blend[i]);
+        sf::Vertex* quad = &vertices[b][used[b]];
+        used[b] += 6;
+        quad[0].position = sf::Vector2f(x - half, y - half);
+        quad[1].position = sf::Vector2f(x + half, y - half);
+        quad[2].position = sf::Vector2f(x + half, y + half);
+        quad[3].position = quad[0].position;
+        quad[4].position = quad[2].position;
+        quad[5].position = sf::Vector2f(x - half, y + half);
+        for (int v = 0; v < 6; v++) {
+            quad[v].color = c;
+        }
+    }
+
+    for (int b = 0; b < blendCount; b++) {
+        vertices[b].resize(used[b]);
+        if (used[b] > 0) {
+            target.draw(vertices[b], b == static_cast<int>(ParticleBlend::ADDITIVE) ? sf::BlendAdd : sf::BlendAlpha);
+        }
+    }
+}
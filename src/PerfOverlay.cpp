@@ -0,0 +1,100 @@
+#include "../include/PerfOverlay.h"
+#include "../include/View.h"
+#include "../include/FrameArena.h"
+#include "../include/MemoryBudget.h"
+#include <algorithm>
+
+PerfOverlay::PerfOverlay()
+    : visible(false), frameMilliseconds(0.f), workMilliseconds(0.f) {
+    resetLatency();
+}
+
+void PerfOverlay::recordFrame(sf::Time frameTime, sf::Time workTime) {
+    frameMilliseconds += (frameTime.asSeconds() * 1000.f - frameMilliseconds) * 0.1f;
+    workMilliseconds += (workTime.asSeconds() * 1000.f - workMilliseconds) * 0.1f;
+}
+
+void PerfOverlay::recordLatency(sf::Time latency) {
+    sf::Int64 microseconds = std::max<sf::Int64>(0, latency.asMicroseconds());
+    int bucket = static_cast<int>(std::min<sf::Int64>(LATENCY_BUCKETS - 1, microseconds / (LATENCY_BUCKET_MS * 1000)));
+    latencyCounts[bucket]++;
+    latencySamples++;
+    latencyTotalMicroseconds += microseconds;
+}
+
+void PerfOverlay::resetLatency() {
+    std::fill(latencyCounts, latencyCounts + LATENCY_BUCKETS, 0u);
+    latencySamples = 0;
+    latencyTotalMicroseconds = 0;
+}
+
+float PerfOverlay::getLatencyPercentile(float fraction) const {
+    if (latencySamples == 0) return 0.f;
+
+    std::uint32_t target = static_cast<std::uint32_t>(fraction * latencySamples);
+    std::uint32_t seen = 0;
+    for (int b = 0; b < LATENCY_BUCKETS; b++) {
+        seen += latencyCounts[b];
+        if (seen > target) {
+            return static_cast<float>((b + 1) * LATENCY_BUCKET_MS);
+        }
+    }
+    return static_cast<float>(LATENCY_BUCKETS * LATENCY_BUCKET_MS);
+}
+
+float PerfOverlay::getAverageLatency() const {
+    return latencySamples ? latencyTotalMicroseconds / 1000.f / latencySamples : 0.f;
+}
+
+void PerfOverlay::draw(float x, float y, bool lateInputSampling) const {
+    if (!visible) return;
+
+    static const float WIDTH = 260.f;
+    static const float HISTOGRAM_HEIGHT = 40.f;
+
+    View::resetView();
+    View::drawRectangle(x, y, WIDTH, 160.f + HISTOGRAM_HEIGHT, sf::Color(0, 0, 0, 170));
+
+    sf::Color textColor = View::getTextColor();
+    View::drawText(FrameArena::format("frame %.2f ms  work %.2f ms", frameMilliseconds, workMilliseconds),
+                   x + 8, y + 6, 14, textColor);
+    View::drawText(FrameArena::format("input sampling: %s (F4)", lateInputSampling ? "late" : "early"),
+                   x + 8, y + 26, 14, textColor);
+    View::drawText(FrameArena::format("input->present avg %.1f  p50 %.0f  p99 %.0f ms",
+                                      getAverageLatency(), getLatencyPercentile(0.5f), getLatencyPercentile(0.99f)),
+                   x + 8, y + 46, 14, textColor);
+    View::drawText(FrameArena::format("%u samples", latencySamples), x + 8, y + 66, 14, textColor);
+
+    // Texture and sound memory against the budget
+    const float MB = 1024.f * 1024.f;
+    View::drawText(FrameArena::format("tex %.1f  rt %.1f  snd %.1f MB",
+                                      MemoryBudget::getUsage(MemoryCategory::TEXTURE) / MB,
+                                      MemoryBudget::getUsage(MemoryCategory::RENDER_TEXTURE) / MB,
+                                      MemoryBudget::getUsage(MemoryCategory::SOUND) / MB),
+                   x + 8, y + 86, 14, textColor);
+    if (MemoryBudget::getBudget() > 0) {
+        View::drawText(FrameArena::format("total %.1f / %.0f MB  peak %.1f  %u evicted", MemoryBudget::getTotal() / MB,
+                                          MemoryBudget::getBudget() / MB, MemoryBudget::getPeakTotal() / MB,
+                                          MemoryBudget::getEvictionCount()),
+                       x + 8, y + 106, 14, MemoryBudget::exceeds() ? sf::Color::Red : textColor);
+    } else {
+        View::drawText(FrameArena::format("total %.1f MB  peak %.1f  no budget", MemoryBudget::getTotal() / MB,
+                                          MemoryBudget::getPeakTotal() / MB),
+                       x + 8, y + 106, 14, textColor);
+    }
+
+    // Latency histogram, 1 ms per bar, scaled to the tallest bar
+    std::uint32_t tallest = *std::max_element(latencyCounts, latencyCounts + LATENCY_BUCKETS);
+    if (tallest == 0) return;
+    float barWidth = (WIDTH - 16.f) / LATENCY_BUCKETS;
+    float baseline = y + 140.f + HISTOGRAM_HEIGHT;
+    for (int b = 0; b < LATENCY_BUCKETS; b++) {
+        if (latencyCounts[b] == 0) continue;
+        float height = HISTOGRAM_HEIGHT * latencyCounts[b] / tallest;
+        View::drawRectangle(x + 8.f + b * barWidth, baseline - height, barWidth - 1.f, height,
+                            b == LATENCY_BUCKETS - 1 ? sf::Color::Red : View::getAccentColor());
+    }
+    View::drawText("0", x + 8, baseline + 2, 12, textColor);
+    View::drawText(FrameArena::format("%d+ ms", LATENCY_BUCKETS * LATENCY_BUCKET_MS),
+                   x + WIDTH - 50, baseline + 2, 12, textColor);
+}
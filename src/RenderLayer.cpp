@@ -0,0 +1,33 @@
+#include "../include/RenderLayer.h"
+#include "../include/View.h"
+#include <iostream>
+
+RenderLayer::RenderLayer()
+    : textureCharge(MemoryCategory::RENDER_TEXTURE), clearColor(sf::Color::Black), created(false), dirty(true), redrawCount(0) {
+}
+
+bool RenderLayer::create(unsigned int width, unsigned int height, sf::Color layerClearColor) {
+    created = texture.create(width, height);
+    textureCharge.set(created ? MemoryBudget::bytesOf(texture.getTexture()) : 0);
+    if (!created) {
+        std::cerr << "Could not create a " << width << "x" << height
+                  << " render layer, drawing it directly instead" << std::endl;
+        return false;
+    }
+    sprite.setTexture(texture.getTexture(), true);
+    clearColor = layerClearColor;
+    dirty = true;
+    return true;
+}
+
+void RenderLayer::beginRedraw() {
+    texture.clear(clearColor);
+    View::setRenderTarget(&texture);
+}
+
+void RenderLayer::endRedraw() {
+    View::setRenderTarget(nullptr);
+    texture.display();
+    dirty = false;
+    redrawCount++;
+}
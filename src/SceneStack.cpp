@@ -0,0 +1,118 @@
+#include "../include/SceneStack.h"
+#include "../include/View.h"
+
+SceneStack::SceneStack()
+    : window(nullptr), staticLayerScene(nullptr), frozenFrameValid(false) {
+}
+
+void SceneStack::initialize(sf::RenderWindow* renderWindow) {
+    window = renderWindow;
+    if (!window) return;
+
+    staticLayer.create(window->getSize().x, window->getSize().y);
+    if (frozenFrame.create(window->getSize().x, window->getSize().y)) {
+        frozenFrameCharge.set(frozenFrame);
+        frozenSprite.setTexture(frozenFrame, true);
+    }
+}
+
+void SceneStack::push(Scene* scene) {
+    pending.push_back({Change::PUSH, scene});
+}
+
+void SceneStack::pop() {
+    pending.push_back({Change::POP, nullptr});
+}
+
+void SceneStack::reset(Scene* root) {
+    pending.push_back({Change::RESET, root});
+}
+
+void SceneStack::applyChanges() {
+    if (pending.empty()) return;
+
+    for (const PendingChange& change : pending) {
+        if (change.change != Change::PUSH) {
+            // POP removes the top scene, RESET all of them
+            while (!scenes.empty()) {
+                Scene* removed = scenes.back();
+                scenes.pop_back();
+                removed->onExit();
+                if (change.change == Change::POP) break;
+            }
+        }
+        if (change.scene) {
+            // A scene pushed over a live scene freezes a fresh frame of it
+            if (change.scene->showsSceneBelow() && !scenes.empty()) {
+                frozenFrameValid = false;
+            }
+            scenes.push_back(change.scene);
+            change.scene->onEnter();
+        }
+    }
+    pending.clear();
+    staticLayer.markDirty();
+}
+
+void SceneStack::handleEvent(const sf::Event& event) {
+    // Any key or typed character may change what a static screen shows, and
+    // focus or size changes (restoring a window included) need a fresh frame
+    if (event.type == sf::Event::KeyPressed || event.type == sf::Event::TextEntered ||
+        event.type == sf::Event::GainedFocus || event.type == sf::Event::Resized) {
+        staticLayer.markDirty();
+    }
+    if (Scene* scene = top()) {
+        scene->handleEvent(event);
+    }
+}
+
+void SceneStack::update() {
+    if (Scene* scene = top()) {
+        scene->update();
+    }
+}
+
+void SceneStack::freezeSceneBelow() {
+    // Draw the covered scene once more and keep the result
+    frozenFrameValid = false;
+    if (scenes.size() < 2 || frozenFrame.getSize().x == 0) return;
+
+    scenes[scenes.size() - 2]->render();
+    frozenFrame.update(*window);
+    frozenFrameValid = true;
+    staticLayer.markDirty();
+    View::clear();
+}
+
+void SceneStack::render() {
+    Scene* scene = top();
+    if (!scene || !window) return;
+
+    bool withBelow = scene->showsSceneBelow() && scenes.size() >= 2;
+    if (withBelow && !frozenFrameValid) {
+        freezeSceneBelow();
+    }
+
+    auto drawScene = [this, scene, withBelow]() {
+        if (withBelow && frozenFrameValid) {
+            View::drawBackground(frozenSprite);
+        }
+        scene->render();
+    };
+
+    if (scene->isStatic()) {
+        // One textured quad, unless the screen changed since it was last drawn
+        if (scene != staticLayerScene) {
+            staticLayerScene = scene;
+            staticLayer.markDirty();
+        }
+        staticLayer.draw(*window, drawScene);
+    } else {
+        drawScene();
+    }
+}
+
+bool SceneStack::isIdle() const {
+    Scene* scene = top();
+    return scene && !scene->isAnimating() && pending.empty() && !staticLayer.isDirty();
+}
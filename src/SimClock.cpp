@@ -0,0 +1,10 @@
+#include "../include/SimClock.h"
+
+// Static member definitions
+std::uint32_t SimClock::tick = 0;
+TimerWheel SimClock::timers;
+
+void SimClock::advance() {
+    tick++;
+    timers.advanceTo(tick);
+}
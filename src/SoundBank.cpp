@@ -0,0 +1,138 @@
+#include "../include/SoundBank.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// In SoundId order                          path                          priority volume pitch
+const SoundEffect SoundBank::EFFECTS[static_cast<int>(SoundId::COUNT)] = {
+    /* HIT         */ {"assets/sfx/hit.wav",          1, 60.f, 0.10f},
+    /* MAGIC_HIT   */ {"assets/sfx/magic_hit.wav",    1, 60.f, 0.10f},
+    /* SWORD_HIT   */ {"assets/sfx/sword_hit.wav",    1, 70.f, 0.08f},
+    /* PLAYER_HURT */ {"assets/sfx/player_hurt.wav",  3, 90.f, 0.05f},
+    /* ENEMY_DEATH */ {"assets/sfx/enemy_death.wav",  2, 80.f, 0.10f},
+};
+
+SoundBank::SoundBank()
+    : assets(nullptr), requestCount(0), masterVolume(100.f), randomState(2024u) {
+    std::fill(buffers, buffers + static_cast<int>(SoundId::COUNT), 0);
+    for (Voice& voice : voices) {
+        voice.id = SoundId::HIT;
+        voice.priority = 0;
+        voice.distance = 0.f;
+    }
+}
+
+SoundBank::~SoundBank() {
+    stopAll();
+}
+
+void SoundBank::load(AssetLoader& loader) {
+    assets = &loader;
+    int missing = 0;
+    for (int i = 0; i < static_cast<int>(SoundId::COUNT); i++) {
+        if (!loader.exists(EFFECTS[i].path)) {
+            missing++; // stays 0: that effect is silent
+            continue;
+        }
+        buffers[i] = loader.requestSound(EFFECTS[i].path);
+        loader.retain(buffers[i]); // voices point into the buffers
+    }
+    if (missing > 0) {
+        std::cout << "Sound effects: " << missing << " of " << static_cast<int>(SoundId::COUNT)
+                  << " missing from assets/sfx, those stay silent" << std::endl;
+    }
+}
+
+void SoundBank::play(SoundId id, sf::Vector2f position) {
+    sf::Vector2f offset = position - listener;
+    float distance = std::sqrt(offset.x * offset.x + offset.y * offset.y);
+    if (distance >= AUDIBLE_DISTANCE) return;
+
+    // A volley hitting ten enemies in one tick is one sound, from the nearest hit
+    for (int i = 0; i < requestCount; i++) {
+        if (requests[i].id == id) {
+            requests[i].distance = std::min(requests[i].distance, distance);
+            return;
+        }
+    }
+    requests[requestCount++] = {id, distance}; // at most one per effect, so it always fits
+}
+
+void SoundBank::flush(sf::Vector2f newListener) {
+    // Most important first, so the last free or stealable voices go to them
+    std::sort(requests, requests + requestCount, [](const Request& a, const Request& b) {
+        std::uint8_t priorityA = EFFECTS[static_cast<int>(a.id)].priority;
+        std::uint8_t priorityB = EFFECTS[static_cast<int>(b.id)].priority;
+        return priorityA != priorityB ? priorityA > priorityB : a.distance < b.distance;
+    });
+
+    for (int i = 0; i < requestCount; i++) {
+        const Request& request = requests[i];
+        const SoundEffect& effect = EFFECTS[static_cast<int>(request.id)];
+        const sf::SoundBuffer* buffer = assets ? assets->getSound(buffers[static_cast<int>(request.id)]) : nullptr;
+        if (!buffer || buffer->getSampleCount() == 0) continue; // still decoding, or no such file
+
+        Voice* voice = pickVoice(effect, *buffer, request.distance);
+        if (!voice) continue; // every voice is busy with something that matters more
+
+        if (voice->sound.getBuffer() != buffer) {
+            voice->sound.setBuffer(*buffer);
+        }
+        voice->id = request.id;
+        voice->priority = effect.priority;
+        voice->distance = request.distance;
+        voice->sound.setVolume(effect.volume * (1.f - request.distance / AUDIBLE_DISTANCE) * masterVolume / 100.f);
+        voice->sound.setPitch(randomPitch(effect.pitchVariation));
+        voice->sound.play(); // restarts a stolen voice
+    }
+
+    requestCount = 0;
+    listener = newListener;
+}
+
+SoundBank::Voice* SoundBank::pickVoice(const SoundEffect& effect, const sf::SoundBuffer& buffer, float distance) {
+    Voice* idle = nullptr;
+    Voice* victim = nullptr;
+    for (Voice& voice : voices) {
+        if (voice.sound.getStatus() != sf::Sound::Playing) {
+            // An idle voice that already holds this buffer needs no rebinding
+            if (!idle || (idle->sound.getBuffer() != &buffer && voice.sound.getBuffer() == &buffer)) {
+                idle = &voice;
+            }
+            continue;
+        }
+        if (!victim || voice.priority < victim->priority ||
+            (voice.priority == victim->priority && voice.distance > victim->distance)) {
+            victim = &voice;
+        }
+    }
+    if (idle) return idle;
+
+    // Steal from lower priority, or the same priority farther away
+    if (victim && (victim->priority < effect.priority ||
+                   (victim->priority == effect.priority && victim->distance > distance))) {
+        return victim;
+    }
+    return nullptr;
+}
+
+float SoundBank::randomPitch(float variation) {
+    randomState = randomState * 1664525u + 1013904223u;
+    float unit = static_cast<float>(randomState >> 8) / 16777216.f; // 0..1
+    return 1.f + (unit * 2.f - 1.f) * variation;
+}
+
+void SoundBank::stopAll() {
+    for (Voice& voice : voices) {
+        voice.sound.stop();
+    }
+    requestCount = 0;
+}
+
+int SoundBank::getPlayingCount() const {
+    int playing = 0;
+    for (const Voice& voice : voices) {
+        if (voice.sound.getStatus() == sf::Sound::Playing) playing++;
+    }
+    return playing;
+}
@@ -0,0 +1,67 @@
+#include "../include/SpatialGrid.h"
+#include <algorithm>
+
+SpatialGrid::SpatialGrid(float cellSize, int bucketCount)
+    : cellSize(cellSize), inverseCellSize(1.f / cellSize) {
+    std::uint32_t buckets = 1;
+    while (buckets < static_cast<std::uint32_t>(bucketCount)) {
+        buckets <<= 1;
+    }
+    bucketMask = buckets - 1;
+    bucketStart.assign(buckets + 1, 0);
+}
+
+void SpatialGrid::reserve(int maxItems) {
+    sortedItems.reserve(maxItems);
+    sortedPositions.reserve(maxItems);
+    sortedCells.reserve(maxItems);
+    itemBuckets.reserve(maxItems);
+}
+
+void SpatialGrid::clear() {
+    std::fill(bucketStart.begin(), bucketStart.end(), 0);
+    sortedItems.clear();
+    sortedPositions.clear();
+    sortedCells.clear();
+    itemBuckets.clear();
+}
+
+void SpatialGrid::rebuild(const sf::Vector2f* positions, int count) {
+    clear();
+    if (count <= 0) return;
+
+    // Count items per bucket
+    itemBuckets.resize(count);
+    for (int i = 0; i < count; i++) {
+        itemBuckets[i] = bucketOf(cellCoord(positions[i].x), cellCoord(positions[i].y));
+        bucketStart[itemBuckets[i] + 1]++;
+    }
+
+    // Prefix sum -> first slot of each bucket
+    for (size_t b = 1; b < bucketStart.size(); b++) {
+        bucketStart[b] += bucketStart[b - 1];
+    }
+
+    // Scatter, using bucketStart[b] as the write cursor of bucket b
+    sortedItems.resize(count);
+    sortedPositions.resize(count);
+    sortedCells.resize(count);
+    for (int i = 0; i < count; i++) {
+        int slot = bucketStart[itemBuckets[i]]++;
+        sortedItems[slot] = i;
+        sortedPositions[slot] = positions[i];
+        sortedCells[slot] = cellKey(cellCoord(positions[i].x), cellCoord(positions[i].y));
+    }
+
+    // Each bucketStart[b] now holds the end of bucket b; shift right to restore the starts
+    for (size_t b = bucketStart.size() - 1; b > 0; b--) {
+        bucketStart[b] = bucketStart[b - 1];
+    }
+    bucketStart[0] = 0;
+}
+
+std::size_t SpatialGrid::getMemoryBytes() const {
+    return bucketStart.capacity() * sizeof(int) + sortedItems.capacity() * sizeof(int) +
+           sortedPositions.capacity() * sizeof(sf::Vector2f) + sortedCells.capacity() * sizeof(std::uint64_t) +
+           itemBuckets.capacity() * sizeof(std::uint32_t);
+}
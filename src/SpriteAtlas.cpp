@@ -0,0 +1,89 @@
+#include "../include/SpriteAtlas.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+std::vector<SpriteAtlas::Entry> SpriteAtlas::entries;
+
+SpriteFrames SpriteFrames::wholeSheet(sf::Texture* sheet, int frameWidth, int frameHeight, int frameCount,
+                                      sf::Vector2f scale) {
+    sf::Vector2u size = sheet ? sheet->getSize() : sf::Vector2u(0, 0);
+    SpriteFrames frames;
+    frames.texture = sheet;
+    frames.area = sf::IntRect(0, 0, static_cast<int>(size.x), static_cast<int>(size.y));
+    frames.frameWidth = frameWidth;
+    frames.frameHeight = frameHeight;
+    frames.frameCount = frameCount;
+    frames.scale = scale;
+    return frames;
+}
+
+bool SpriteAtlas::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+    return parse(file, path);
+}
+
+bool SpriteAtlas::loadFromMemory(const unsigned char* data, std::size_t size) {
+    std::istringstream input(std::string(reinterpret_cast<const char*>(data), size));
+    return parse(input, "packed atlas table");
+}
+
+bool SpriteAtlas::parse(std::istream& input, const std::string& source) {
+    // Parse into a staging table so a bad file leaves the current one untouched
+    std::vector<Entry> loaded;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(input, line)) {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+
+        std::istringstream fields(line);
+        Entry entry;
+        if (!(fields >> entry.name)) continue;
+
+        if (!(fields >> entry.area.left >> entry.area.top >> entry.area.width >> entry.area.height >>
+              entry.frameWidth >> entry.frameHeight >> entry.frameCount >> entry.scale.x >> entry.scale.y) ||
+            entry.frameWidth <= 0 || entry.frameHeight <= 0 || entry.frameCount <= 0 ||
+            entry.area.width < entry.frameWidth || entry.area.height < entry.frameHeight) {
+            std::cerr << "Warning: " << source << ":" << lineNumber << ": invalid atlas entry, atlas not used" << std::endl;
+            return false;
+        }
+        loaded.push_back(entry);
+    }
+
+    entries.swap(loaded);
+    std::cout << "Sprite atlas: " << entries.size() << " entries from " << source << std::endl;
+    return !entries.empty();
+}
+
+const SpriteAtlas::Entry* SpriteAtlas::find(const std::string& name) {
+    for (const Entry& entry : entries) {
+        if (entry.name == name) return &entry;
+    }
+    return nullptr;
+}
+
+bool SpriteAtlas::getFrames(const std::string& name, sf::Texture* atlas, SpriteFrames& frames) {
+    const Entry* entry = find(name);
+    if (!entry) return false;
+
+    frames.texture = atlas;
+    frames.area = entry->area;
+    frames.frameWidth = entry->frameWidth;
+    frames.frameHeight = entry->frameHeight;
+    frames.frameCount = entry->frameCount;
+    frames.scale = entry->scale;
+    return true;
+}
+
+bool SpriteAtlas::getRect(const std::string& name, sf::IntRect& rect) {
+    const Entry* entry = find(name);
+    if (!entry) return false;
+
+    rect = entry->area;
+    return true;
+}
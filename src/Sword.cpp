@@ -1,4 +1,5 @@
 #include "../include/Sword.h"
+#include "../include/SimClock.h"
 #include <cmath>
 #include <iostream>
 
@@ -19,9 +20,13 @@ Sword::Sword(float x, float y, sf::Vector2f direction)
     damage = 35; // Higher damage than bullets
     
     isSwinging = false;
+    swingStartTick = 0;
     swingDuration = 200.f; // 200ms swing duration
     swingAngle = 0.f;
     baseAngle = 0.f;
+    attackCounter = 0;
+    swingId = 0;
+    specialSkillId = 0;
     swingDirection = direction;
 
     // Special skill setup
@@ -33,12 +38,17 @@ Sword::Sword(float x, float y, sf::Vector2f direction)
 
 void Sword::update() {
     if (isSwinging) {
-        float elapsed = swingTimer.getElapsedTime().asMilliseconds();
+        float elapsed = (SimClock::now() - swingStartTick) * 1000.f / SimClock::TICKS_PER_SECOND;
         
         if (elapsed >= swingDuration) {
-            // Swing finished
-            isSwinging = false;
-            swingAngle = 0.f;
+            if (swingAngle >= SWING_HALF_ARC) {
+                // Swing finished (the full arc was live for one tick)
+                isSwinging = false;
+                swingAngle = 0.f;
+            } else {
+                // Last tick: complete the arc so hit detection covers all of it
+                swingAngle = SWING_HALF_ARC;
+            }
         } else {
             // Calculate swing progress (0.0 to 1.0)
             float progress = elapsed / swingDuration;
@@ -75,8 +85,9 @@ void Sword::startSwing(sf::Vector2f direction) {
     if (!isSwinging) {
         isSwinging = true;
         swingDirection = direction;
-        swingTimer.restart();
-        swingAngle = 0.f;
+        swingStartTick = SimClock::now();
+        swingAngle = -SWING_HALF_ARC;
+        swingId = ++attackCounter;
         
         // Calculate base angle for swing direction
         baseAngle = std::atan2(direction.y, direction.x) * 180.f / 3.14159f;
@@ -105,6 +116,16 @@ sf::FloatRect Sword::getSwingArea() const {
     );
 }
 
+HitShape Sword::getSwingShape() const {
+    // Sector from the start of the arc to the blade's current angle
+    const float degreesToRadians = 3.14159f / 180.f;
+    float directionAngle = std::atan2(swingDirection.y, swingDirection.x) / degreesToRadians;
+    float sweptHalf = (swingAngle + SWING_HALF_ARC) * 0.5f;
+    float centerAngle = directionAngle - SWING_HALF_ARC + sweptHalf;
+    return HitShape::sector(shape.getPosition(), centerAngle * degreesToRadians,
+                            (sweptHalf + BLADE_HALF_WIDTH_DEG) * degreesToRadians, BLADE_LENGTH);
+}
+
 sf::FloatRect Sword::getBounds() const {
     if (isSwinging) {
         return getSwingArea();
@@ -122,6 +143,7 @@ void Sword::setPosition(sf::Vector2f position) {
 void Sword::startSpecialSkill(sf::Vector2f direction) {
     isUsingSpecialSkill = true;
     swingDirection = direction;
+    specialSkillId = ++attackCounter;
 
     // Position and rotate the special slash
     sf::Vector2f pos = shape.getPosition();
@@ -151,3 +173,7 @@ sf::FloatRect Sword::getSpecialSkillArea() const {
         radius * 2
     );
 }
+
+HitShape Sword::getSpecialSkillShape() const {
+    return HitShape::capsule(shape.getPosition(), BaseObject::normalize(swingDirection), SLASH_LENGTH, SLASH_RADIUS);
+}
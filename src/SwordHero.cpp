@@ -4,9 +4,10 @@
 #include <iostream>
 #include <cmath>
 
-SwordHero::SwordHero() {
+SwordHero::SwordHero(const SpriteFrames* frames) {
     shape.setFillColor(sf::Color::Blue); // màu xanh để phân biệt
     isUsingSpecialSkill = false;
+    specialSkillTimer = 0;
     hasUsedSkillBefore = false;
 
     // Set SwordHero-specific combat parameters
@@ -19,7 +20,11 @@ SwordHero::SwordHero() {
     sword = std::make_unique<Sword>(pos.x, pos.y, aimDirection);
     
     // Setup SwordHero animation from spritesheet using config values
-    setupPlayerAnimation("../assets/Gun_player_spritesheet.png", PLAYER_FRAME_WIDTH, PLAYER_FRAME_HEIGHT, PLAYER_FRAME_COUNT);
+    setupPlayerAnimation(frames);
+}
+
+SwordHero::~SwordHero() {
+    SimClock::getTimers().cancel(specialSkillTimer); // the wheel must not call a destroyed hero
 }
 
 void SwordHero::update(const Map* map) {
@@ -33,8 +38,12 @@ void SwordHero::update(const Map* map) {
         sword->update();
     }
 
-    // Handle special skill duration
-    if (isUsingSpecialSkill && specialSkillTimer.getElapsedTime().asMilliseconds() > 500) {
+    // Special skill duration is handled by onTimer()
+}
+
+void SwordHero::onTimer(int eventId) {
+    if (eventId == EVENT_SPECIAL_SKILL_END) {
+        specialSkillTimer = 0;
         isUsingSpecialSkill = false;
         if (sword) {
             sword->stopSpecialSkill();
@@ -54,7 +63,9 @@ void SwordHero::executeAttack() {
 void SwordHero::executeSkill() {
     // Implementation without cooldown check (handled by template method)
     isUsingSpecialSkill = true;
-    specialSkillTimer.restart();
+    SimClock::getTimers().cancel(specialSkillTimer);
+    specialSkillTimer = SimClock::getTimers().schedule(SimClock::millisecondsToTicks(SPECIAL_SKILL_DURATION_MS), this,
+                                                       EVENT_SPECIAL_SKILL_END);
     hasUsedSkillBefore = true; // Mark that skill has been used
 
     // Long range slash - much larger attack area
@@ -94,11 +105,30 @@ sf::FloatRect SwordHero::getAttackArea() const {
     return sf::FloatRect(0, 0, 0, 0); // No attack area when not attacking
 }
 
+bool SwordHero::getAttackShape(HitShape& attackShape) const {
+    if (!sword) return false;
+    if (isUsingSpecialSkill) {
+        attackShape = sword->getSpecialSkillShape();
+        return true;
+    }
+    if (sword->isSwingActive()) {
+        attackShape = sword->getSwingShape();
+        return true;
+    }
+    return false;
+}
+
+std::uint32_t SwordHero::getAttackId() const {
+    if (!sword) return 0;
+    // Slashes and swings count separately; the top bit keeps their ids apart
+    return isUsingSpecialSkill ? (sword->getSpecialSkillId() | 0x80000000u) : sword->getSwingId();
+}
+
 // Removed - now uses Character::canAttack()
 
 bool SwordHero::canUseSkill() const {
     // Allow skill if level >= 10 and (first time use OR cooldown expired)
-    return level >= 10 && (!hasUsedSkillBefore || skillCooldown.getElapsedTime().asMilliseconds() > 3000);
+    return level >= 10 && (!hasUsedSkillBefore || skillCooldown.isReady());
 }
 
 bool SwordHero::getIsAttacking() const {
@@ -0,0 +1,135 @@
+#include "../include/TimerWheel.h"
+#include <iostream>
+
+TimerWheel::TimerWheel(int capacity)
+    : freeHead(-1), activeCount(0), currentTick(0) {
+    if (capacity > 0xFFFF) capacity = 0xFFFF; // handle packs the index in 16 bits
+    nodes.resize(capacity);
+    slotHeads.assign(SLOT_COUNT, -1);
+    clear();
+}
+
+void TimerWheel::clear() {
+    std::fill(slotHeads.begin(), slotHeads.end(), -1);
+    for (int i = 0; i < static_cast<int>(nodes.size()); i++) {
+        nodes[i].slot = -1;
+        nodes[i].prev = -1;
+        nodes[i].next = i + 1 < static_cast<int>(nodes.size()) ? i + 1 : -1;
+        nodes[i].generation++;
+    }
+    freeHead = nodes.empty() ? -1 : 0;
+    activeCount = 0;
+}
+
+void TimerWheel::link(int node, int slot) {
+    Node& n = nodes[node];
+    n.slot = slot;
+    n.prev = -1;
+    n.next = slotHeads[slot];
+    if (n.next >= 0) nodes[n.next].prev = node;
+    slotHeads[slot] = node;
+}
+
+void TimerWheel::unlink(int node) {
+    Node& n = nodes[node];
+    if (n.prev >= 0) nodes[n.prev].next = n.next;
+    else slotHeads[n.slot] = n.next;
+    if (n.next >= 0) nodes[n.next].prev = n.prev;
+    n.slot = -1;
+}
+
+void TimerWheel::release(int node) {
+    Node& n = nodes[node];
+    n.generation++; // invalidates outstanding handles
+    n.listener = nullptr;
+    n.next = freeHead;
+    freeHead = node;
+    activeCount--;
+}
+
+void TimerWheel::insert(int node) {
+    std::uint32_t due = nodes[node].due;
+    std::uint32_t delta = due - currentTick;
+    int slot;
+    if (delta < LEVEL0_SLOTS) {
+        slot = due & (LEVEL0_SLOTS - 1);
+    } else if (delta < (1u << (LEVEL0_BITS + LEVEL_BITS))) {
+        slot = LEVEL0_SLOTS + ((due >> LEVEL0_BITS) & (LEVEL_SLOTS - 1));
+    } else {
+        slot = LEVEL0_SLOTS + LEVEL_SLOTS + ((due >> (LEVEL0_BITS + LEVEL_BITS)) & (LEVEL_SLOTS - 1));
+    }
+    link(node, slot);
+}
+
+void TimerWheel::cascade(int slot) {
+    int node = slotHeads[slot];
+    slotHeads[slot] = -1;
+    while (node >= 0) {
+        int next = nodes[node].next;
+        insert(node);
+        node = next;
+    }
+}
+
+TimerWheel::Handle TimerWheel::schedule(std::uint32_t delayTicks, TimerListener* listener, int eventId) {
+    if (freeHead < 0 || !listener) {
+        std::cerr << "Warning: timer pool full, event " << eventId << " dropped" << std::endl;
+        return 0;
+    }
+    if (delayTicks < 1) delayTicks = 1;
+    if (delayTicks > MAX_DELAY) delayTicks = MAX_DELAY;
+
+    int node = freeHead;
+    freeHead = nodes[node].next;
+    activeCount++;
+
+    Node& n = nodes[node];
+    n.due = currentTick + delayTicks;
+    n.listener = listener;
+    n.eventId = eventId;
+    insert(node);
+
+    return (static_cast<Handle>(n.generation) << 16) | static_cast<Handle>(node + 1);
+}
+
+bool TimerWheel::isPending(Handle handle) const {
+    int node = static_cast<int>(handle & 0xFFFF) - 1;
+    return node >= 0 && node < static_cast<int>(nodes.size()) &&
+           nodes[node].generation == static_cast<std::uint16_t>(handle >> 16) && nodes[node].slot >= 0;
+}
+
+bool TimerWheel::cancel(Handle handle) {
+    if (!isPending(handle)) return false;
+    int node = static_cast<int>(handle & 0xFFFF) - 1;
+    unlink(node);
+    release(node);
+    return true;
+}
+
+void TimerWheel::advanceTo(std::uint32_t tick) {
+    while (currentTick != tick) {
+        currentTick++;
+
+        // Entering a new 256-tick span: pull its coarse slot down (and the
+        // coarsest one first when entering a new 16384-tick span)
+        if ((currentTick & (LEVEL0_SLOTS - 1)) == 0) {
+            std::uint32_t level1Index = (currentTick >> LEVEL0_BITS) & (LEVEL_SLOTS - 1);
+            if (level1Index == 0) {
+                cascade(LEVEL0_SLOTS + LEVEL_SLOTS + ((currentTick >> (LEVEL0_BITS + LEVEL_BITS)) & (LEVEL_SLOTS - 1)));
+            }
+            cascade(LEVEL0_SLOTS + level1Index);
+        }
+
+        // Fire this tick's slot. Callbacks may schedule or cancel freely: new
+        // timers are at least one tick away, so they never land in this slot.
+        int slot = currentTick & (LEVEL0_SLOTS - 1);
+        while (slotHeads[slot] >= 0) {
+            int node = slotHeads[slot];
+            TimerListener* listener = nodes[node].listener;
+            int eventId = nodes[node].eventId;
+            unlink(node);
+            release(node);
+            listener->onTimer(eventId);
+        }
+    }
+}
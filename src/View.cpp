@@ -3,16 +3,24 @@
 #include "../include/Enemy.h"
 #include "../include/Map.h"
 #include "../include/Camera.h"
+#include "../include/Minimap.h"
+#include "../include/FrameArena.h"
 #include <cmath>
 #include <iostream>
 
 // Static member definitions
 sf::RenderWindow* View::window = nullptr;
+sf::RenderTarget* View::target = nullptr;
 sf::Font* View::font = nullptr;
 Camera* View::camera = nullptr;
+sf::Text View::textObject;
+sf::String View::textBuffer;
+sf::RectangleShape View::rectangleObject;
+sf::CircleShape View::circleObject;
 
 // Background textures
 sf::Texture View::menuBackgroundTexture;
+MemoryCharge View::menuBackgroundCharge;
 sf::Sprite View::menuBackgroundSprite;
 bool View::menuBackgroundLoaded = false;
 
@@ -25,6 +33,7 @@ sf::Color View::textColor = sf::Color::White;
 
 void View::initialize(sf::RenderWindow* gameWindow, sf::Font* gameFont, Camera* gameCamera) {
     window = gameWindow;
+    target = gameWindow;
     font = gameFont;
     camera = gameCamera;
 }
@@ -33,6 +42,10 @@ void View::setCamera(Camera* gameCamera) {
     camera = gameCamera;
 }
 
+void View::setRenderTarget(sf::RenderTarget* renderTarget) {
+    target = renderTarget ? renderTarget : window;
+}
+
 void View::clear(sf::Color color) {
     if (window) {
         window->clear(color);
@@ -47,20 +60,8 @@ void View::display() {
 
 bool View::loadMenuBackground(const std::string& filepath) {
     if (menuBackgroundTexture.loadFromFile(filepath)) {
-        menuBackgroundSprite.setTexture(menuBackgroundTexture);
-
-        // Scale the sprite to fit the window
-        if (window) {
-            sf::Vector2u windowSize = window->getSize();
-            sf::Vector2u textureSize = menuBackgroundTexture.getSize();
-
-            float scaleX = static_cast<float>(windowSize.x) / static_cast<float>(textureSize.x);
-            float scaleY = static_cast<float>(windowSize.y) / static_cast<float>(textureSize.y);
-
-            menuBackgroundSprite.setScale(scaleX, scaleY);
-        }
-
-        menuBackgroundLoaded = true;
+        menuBackgroundCharge.set(menuBackgroundTexture);
+        setMenuBackground(menuBackgroundTexture);
         std::cout << "Menu background loaded successfully from: " << filepath << std::endl;
         return true;
     } else {
@@ -70,83 +71,118 @@ bool View::loadMenuBackground(const std::string& filepath) {
     }
 }
 
+void View::setMenuBackground(const sf::Texture& texture) {
+    menuBackgroundSprite.setTexture(texture, true);
+
+    // Scale the sprite to fit the window
+    sf::Vector2u textureSize = texture.getSize();
+    if (window && textureSize.x > 0 && textureSize.y > 0) {
+        sf::Vector2u windowSize = window->getSize();
+
+        float scaleX = static_cast<float>(windowSize.x) / static_cast<float>(textureSize.x);
+        float scaleY = static_cast<float>(windowSize.y) / static_cast<float>(textureSize.y);
+
+        menuBackgroundSprite.setScale(scaleX, scaleY);
+    }
+
+    menuBackgroundLoaded = textureSize.x > 0;
+}
+
+void View::clearMenuBackground() {
+    menuBackgroundLoaded = false;
+}
+
 void View::drawMenuBackground() {
-    if (window && menuBackgroundLoaded) {
+    if (target && menuBackgroundLoaded) {
         // Reset to default view for background
         resetView();
-        window->draw(menuBackgroundSprite);
+        target->draw(menuBackgroundSprite);
     }
 }
 
+void View::drawBackground(const sf::Sprite& sprite) {
+    if (!target) return;
+
+    resetView();
+    target->draw(sprite);
+}
+
 void View::drawText(const std::string& text, float x, float y, int fontSize, sf::Color color, bool centered) {
     drawText(text, sf::Vector2f(x, y), fontSize, color, centered);
 }
 
 void View::drawText(const std::string& text, sf::Vector2f position, int fontSize, sf::Color color, bool centered) {
-    if (!window || !font) return;
+    drawText(text.c_str(), position.x, position.y, fontSize, color, centered);
+}
+
+void View::drawText(const char* text, float x, float y, int fontSize, sf::Color color, bool centered) {
+    if (!target || !font) return;
     
-    sf::Text textObj;
-    textObj.setFont(*font);
-    textObj.setString(text);
-    textObj.setCharacterSize(fontSize);
-    textObj.setFillColor(color);
+    // Widen into the reused buffer: building an sf::String from the char* would allocate every call
+    textBuffer.clear();
+    for (const char* c = text; *c; ++c) {
+        textBuffer += sf::String(static_cast<sf::Uint32>(static_cast<unsigned char>(*c)));
+    }
+
+    textObject.setFont(*font);
+    textObject.setString(textBuffer);
+    textObject.setCharacterSize(fontSize);
+    textObject.setFillColor(color);
     
     if (centered) {
-        sf::FloatRect textBounds = textObj.getLocalBounds();
-        textObj.setOrigin(textBounds.width / 2.f, textBounds.height / 2.f);
+        sf::FloatRect textBounds = textObject.getLocalBounds();
+        textObject.setOrigin(textBounds.width / 2.f, textBounds.height / 2.f);
+    } else {
+        textObject.setOrigin(0.f, 0.f);
     }
     
-    textObj.setPosition(position);
-    window->draw(textObj);
+    textObject.setPosition(x, y);
+    target->draw(textObject);
 }
 
 void View::drawRectangle(float x, float y, float width, float height, 
                         sf::Color fillColor, sf::Color outlineColor, float outlineThickness) {
-    if (!window) return;
+    if (!target) return;
     
-    sf::RectangleShape rect(sf::Vector2f(width, height));
-    rect.setPosition(x, y);
-    rect.setFillColor(fillColor);
-    
-    if (outlineThickness > 0) {
-        rect.setOutlineColor(outlineColor);
-        rect.setOutlineThickness(outlineThickness);
-    }
+    rectangleObject.setSize(sf::Vector2f(width, height));
+    rectangleObject.setPosition(x, y);
+    rectangleObject.setRotation(0.f);
+    rectangleObject.setFillColor(fillColor);
+    rectangleObject.setOutlineColor(outlineColor);
+    rectangleObject.setOutlineThickness(outlineThickness > 0 ? outlineThickness : 0.f);
     
-    window->draw(rect);
+    target->draw(rectangleObject);
 }
 
 void View::drawCircle(float x, float y, float radius, 
                      sf::Color fillColor, sf::Color outlineColor, float outlineThickness) {
-    if (!window) return;
+    if (!target) return;
     
-    sf::CircleShape circle(radius);
-    circle.setPosition(x - radius, y - radius); // Center the circle
-    circle.setFillColor(fillColor);
+    circleObject.setRadius(radius);
+    circleObject.setPosition(x - radius, y - radius); // Center the circle
+    circleObject.setFillColor(fillColor);
+    circleObject.setOutlineColor(outlineColor);
+    circleObject.setOutlineThickness(outlineThickness > 0 ? outlineThickness : 0.f);
     
-    if (outlineThickness > 0) {
-        circle.setOutlineColor(outlineColor);
-        circle.setOutlineThickness(outlineThickness);
-    }
-    
-    window->draw(circle);
+    target->draw(circleObject);
 }
 
 void View::drawLine(sf::Vector2f start, sf::Vector2f end, sf::Color color, float thickness) {
-    if (!window) return;
+    if (!target) return;
     
     sf::Vector2f direction = end - start;
     float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
     
-    sf::RectangleShape line(sf::Vector2f(length, thickness));
-    line.setPosition(start);
-    line.setFillColor(color);
+    rectangleObject.setSize(sf::Vector2f(length, thickness));
+    rectangleObject.setPosition(start);
+    rectangleObject.setFillColor(color);
+    rectangleObject.setOutlineThickness(0.f);
     
     // Calculate rotation angle
     float angle = std::atan2(direction.y, direction.x) * 180.f / 3.14159f;
-    line.setRotation(angle);
+    rectangleObject.setRotation(angle);
     
-    window->draw(line);
+    target->draw(rectangleObject);
 }
 
 void View::drawCharacter(const Character* character) {
@@ -161,15 +197,15 @@ void View::drawEnemy(const Enemy* enemy) {
     if (!window || !enemy) return;
     
     // Use enemy's own draw method for now
-    const_cast<Enemy*>(enemy)->draw(*window);
+    enemy->draw(*window);
     
     #if ANIMATION_DEBUG_MODE && ANIMATION_SHOW_FRAME_INFO
     // Debug: kiểm tra animation state khi render
-    if (enemy->isAnimationEnabled() && enemy->getCurrentAnimation()) {
+    if (Enemy::hasSpritesheet()) {
         static int lastRenderFrame = -1;
-        int currentFrame = enemy->getCurrentAnimation()->getCurrentFrameIndex();
+        int currentFrame = enemy->getAnimationFrame();
         if (currentFrame != lastRenderFrame) {
-            std::cout << "Enemy render - Frame: " << currentFrame << "/" << enemy->getCurrentAnimation()->getFrameCount() << std::endl;
+            std::cout << "Enemy render - Frame: " << currentFrame << "/" << enemy->getAnimationFrameCount() << std::endl;
             lastRenderFrame = currentFrame;
         }
     }
@@ -186,7 +222,7 @@ void View::drawMap(const Map* map) {
 void View::drawHealthBar(float x, float y, float width, float height, 
                         float currentHealth, float maxHealth, 
                         sf::Color healthColor, sf::Color bgColor) {
-    if (!window || maxHealth <= 0) return;
+    if (!target || maxHealth <= 0) return;
     
     // Background
     drawRectangle(x, y, width, height, bgColor);
@@ -201,7 +237,7 @@ void View::drawHealthBar(float x, float y, float width, float height,
 
 void View::drawProgressBar(float x, float y, float width, float height, 
                           float progress, sf::Color fillColor, sf::Color bgColor) {
-    if (!window) return;
+    if (!target) return;
     
     // Background
     drawRectangle(x, y, width, height, bgColor);
@@ -216,7 +252,7 @@ void View::drawProgressBar(float x, float y, float width, float height,
 
 void View::drawMenu(const std::vector<std::string>& options, int selectedOption, 
                    float x, float y, float spacing) {
-    if (!window || !font) return;
+    if (!target || !font) return;
     
     for (size_t i = 0; i < options.size(); i++) {
         sf::Color color = (i == selectedOption) ? accentColor : sf::Color::Black;
@@ -226,7 +262,7 @@ void View::drawMenu(const std::vector<std::string>& options, int selectedOption,
 
 void View::drawButton(const std::string& text, float x, float y, float width, float height, 
                      bool selected, sf::Color buttonColor) {
-    if (!window) return;
+    if (!target) return;
     
     sf::Color bgColor = selected ? accentColor : buttonColor;
     sf::Color textCol = selected ? backgroundColor : textColor;
@@ -257,13 +293,13 @@ void View::applyCamera() {
 }
 
 void View::resetView() {
-    if (window) {
-        window->setView(window->getDefaultView());
+    if (target) {
+        target->setView(target->getDefaultView());
     }
 }
 
 void View::drawHUD(const Character* player, int score, int enemiesKilled, float playTime) {
-    if (!window || !player) return;
+    if (!target || !player) return;
 
     // Reset to default view for UI
     resetView();
@@ -272,76 +308,51 @@ void View::drawHUD(const Character* player, int score, int enemiesKilled, float
     float healthPercentage = static_cast<float>(player->getHp()) / static_cast<float>(player->getMaxHp());
     drawHealthBar(20, 20, 200, 20, player->getHp(), player->getMaxHp());
 
-    // Player info
-    drawText("HP: " + std::to_string(player->getHp()) + "/" + std::to_string(player->getMaxHp()),
-             20, 50, 18, textColor);
-    drawText("Level: " + std::to_string(player->getLevel()), 20, 75, 18, textColor);
-    drawText("Score: " + std::to_string(score), 20, 100, 18, textColor);
-    drawText("Enemies: " + std::to_string(enemiesKilled), 20, 125, 18, textColor);
+    // Player info (formatted into the frame arena, no per-frame std::string)
+    drawText(FrameArena::format("HP: %d/%d", player->getHp(), player->getMaxHp()), 20, 50, 18, textColor);
+    drawText(FrameArena::format("Level: %d", player->getLevel()), 20, 75, 18, textColor);
+    drawText(FrameArena::format("Score: %d", score), 20, 100, 18, textColor);
+    drawText(FrameArena::format("Enemies: %d", enemiesKilled), 20, 125, 18, textColor);
 
     // Format time
     int minutes = static_cast<int>(playTime) / 60;
     int seconds = static_cast<int>(playTime) % 60;
-    std::string timeStr = std::to_string(minutes) + ":" +
-                         (seconds < 10 ? "0" : "") + std::to_string(seconds);
-    drawText("Time: " + timeStr, 20, 150, 18, textColor);
+    drawText(FrameArena::format("Time: %d:%02d", minutes, seconds), 20, 150, 18, textColor);
 
     // Player name
-    drawText("Player: " + player->getName(), 20, 175, 18, accentColor);
+    drawText(FrameArena::format("Player: %s", player->getName().c_str()), 20, 175, 18, accentColor);
 }
 
-void View::drawMinimap(const Character* player, const std::vector<Enemy>& enemies,
-                      float x, float y, float size) {
-    if (!window || !player) return;
+void View::drawMinimap(Minimap& minimap) {
+    if (!target) return;
 
     // Reset to default view for UI
     resetView();
 
-    // Minimap background
-    drawRectangle(x, y, size, size, sf::Color(0, 0, 0, 128), sf::Color::White, 2.f);
-
-    // Player position (center of minimap)
-    sf::Vector2f playerPos = player->getPosition();
-    float centerX = x + size / 2.f;
-    float centerY = y + size / 2.f;
-
-    // Draw player
-    drawCircle(centerX, centerY, 3.f, sf::Color::Green);
-
-    // Draw enemies (relative to player)
-    float scale = 0.1f; // Scale factor for minimap
-    for (const auto& enemy : enemies) {
-        sf::Vector2f enemyPos = enemy.getPosition();
-        sf::Vector2f relativePos = enemyPos - playerPos;
-
-        float mapX = centerX + relativePos.x * scale;
-        float mapY = centerY + relativePos.y * scale;
-
-        // Only draw if within minimap bounds
-        if (mapX >= x && mapX <= x + size && mapY >= y && mapY <= y + size) {
-            drawCircle(mapX, mapY, 2.f, sf::Color::Red);
-        }
-    }
+    // Minimap background, then the cached tile texture and the markers on top
+    const sf::FloatRect& rect = minimap.getScreenRect();
+    drawRectangle(rect.left, rect.top, rect.width, rect.height, sf::Color(0, 0, 0, 128), sf::Color::White, 2.f);
+    minimap.draw(*target);
 }
 
 void View::drawFadeOverlay(float alpha, sf::Color color) {
-    if (!window) return;
+    if (!target) return;
 
     resetView();
 
     sf::Color overlayColor = color;
     overlayColor.a = static_cast<sf::Uint8>(alpha * 255);
 
-    sf::Vector2u windowSize = window->getSize();
+    sf::Vector2u windowSize = target->getSize();
     drawRectangle(0, 0, windowSize.x, windowSize.y, overlayColor);
 }
 
 void View::drawBorder(float thickness, sf::Color color) {
-    if (!window) return;
+    if (!target) return;
 
     resetView();
 
-    sf::Vector2u windowSize = window->getSize();
+    sf::Vector2u windowSize = target->getSize();
 
     // Top border
     drawRectangle(0, 0, windowSize.x, thickness, color);
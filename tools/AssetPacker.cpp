@@ -0,0 +1,154 @@
+// Builds an asset pack (see include/AssetPackFile.h) from loose asset files.
+//
+//   asset_packer <output.pak> [--rgba] <file>...
+//
+// Each file is stored under AssetPack::normalizeName() of its path. With --rgba,
+// images are decoded here and stored as RGBA8 pixels so the game can upload them
+// without decoding; other files are always stored as they are.
+
+#include "../include/AssetPack.h"
+#include "../include/MappedFile.h"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct PackedFile {
+    std::string path;
+    std::string name;
+    AssetPackEntry entry;
+    std::vector<unsigned char> pixels; // RGBA8 only
+};
+
+bool isImage(const std::string& name) {
+    static const char* extensions[] = {".png", ".jpg", ".jpeg", ".bmp", ".tga"};
+    for (const char* extension : extensions) {
+        std::size_t length = std::strlen(extension);
+        if (name.size() > length && name.compare(name.size() - length, length, extension) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::uint64_t align(std::uint64_t offset) {
+    return (offset + ASSET_PACK_ALIGNMENT - 1) / ASSET_PACK_ALIGNMENT * ASSET_PACK_ALIGNMENT;
+}
+
+void writePadding(std::ofstream& out, std::uint64_t& offset, std::uint64_t target) {
+    static const char zeros[ASSET_PACK_ALIGNMENT] = {};
+    out.write(zeros, static_cast<std::streamsize>(target - offset));
+    offset = target;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "usage: asset_packer <output.pak> [--rgba] <file>..." << std::endl;
+        return 1;
+    }
+
+    std::string outputPath = argv[1];
+    bool decodeImages = false;
+    std::vector<PackedFile> files;
+    for (int i = 2; i < argc; i++) {
+        if (std::strcmp(argv[i], "--rgba") == 0) {
+            decodeImages = true;
+            continue;
+        }
+        PackedFile file;
+        file.path = argv[i];
+        file.name = AssetPack::normalizeName(file.path);
+        std::memset(&file.entry, 0, sizeof(file.entry));
+        file.entry.nameHash = AssetPack::hashName(file.name);
+        files.push_back(file);
+    }
+
+    // The index is binary searched by hash, so hashes must be unique
+    std::sort(files.begin(), files.end(),
+              [](const PackedFile& a, const PackedFile& b) { return a.entry.nameHash < b.entry.nameHash; });
+    for (std::size_t i = 1; i < files.size(); i++) {
+        if (files[i].entry.nameHash == files[i - 1].entry.nameHash) {
+            std::cerr << files[i - 1].path << " and " << files[i].path << " map to the same name" << std::endl;
+            return 1;
+        }
+    }
+
+    // Write to a temporary file first, like Map::saveToFile
+    std::string tempPath = outputPath + ".tmp";
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Could not open " << tempPath << " for writing" << std::endl;
+        return 1;
+    }
+
+    AssetPackHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, ASSET_PACK_MAGIC, sizeof(header.magic));
+    header.version = ASSET_PACK_VERSION;
+    header.entryCount = static_cast<std::uint32_t>(files.size());
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    std::uint64_t offset = sizeof(header);
+
+    for (PackedFile& file : files) {
+        MappedFile source;
+        if (!source.open(file.path)) {
+            std::cerr << "Could not open " << file.path << std::endl;
+            return 1;
+        }
+
+        const unsigned char* data = source.getData();
+        std::size_t size = source.getSize();
+        file.entry.format = ASSET_PACK_FORMAT_RAW;
+
+        sf::Image image;
+        if (decodeImages && isImage(file.name) && image.loadFromMemory(data, size)) {
+            sf::Vector2u imageSize = image.getSize();
+            if (imageSize.x <= 0xFFFF && imageSize.y <= 0xFFFF) {
+                file.entry.format = ASSET_PACK_FORMAT_RGBA8;
+                file.entry.width = static_cast<std::uint16_t>(imageSize.x);
+                file.entry.height = static_cast<std::uint16_t>(imageSize.y);
+                data = image.getPixelsPtr();
+                size = static_cast<std::size_t>(imageSize.x) * imageSize.y * 4;
+            }
+        }
+
+        writePadding(out, offset, align(offset));
+        file.entry.offset = offset;
+        file.entry.size = size;
+        out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+        offset += size;
+
+        std::cout << file.name << ": " << size << " bytes"
+                  << (file.entry.format == ASSET_PACK_FORMAT_RGBA8 ? " (rgba)" : "") << std::endl;
+    }
+
+    // Index last, then the header again now that its offset is known
+    writePadding(out, offset, align(offset));
+    header.indexOffset = offset;
+    for (const PackedFile& file : files) {
+        out.write(reinterpret_cast<const char*>(&file.entry), sizeof(file.entry));
+    }
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.close();
+    if (!out) {
+        std::cerr << "Failed writing " << tempPath << std::endl;
+        return 1;
+    }
+
+    // Replaces in one step (no window without a pack), also over an existing file on Windows
+    if (!MappedFile::replaceFile(tempPath, outputPath)) {
+        std::cerr << "Could not replace " << outputPath << std::endl;
+        return 1;
+    }
+    std::cout << "Wrote " << outputPath << ": " << files.size() << " assets" << std::endl;
+    return 0;
+}
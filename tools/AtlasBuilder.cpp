@@ -0,0 +1,217 @@
+// Builds the sprite atlas (see include/SpriteAtlas.h) from the loose assets.
+//
+//   atlas_builder <assets dir> [--2x]
+//
+// Each spritesheet is resampled frame by frame to the size it is drawn at on
+// screen (frame size * the scale in AnimationConfig.h; --2x keeps twice that for
+// high-DPI or zoomed views), the tile textures to Map::TILE_SIZE, and everything
+// is packed into <dir>/atlas.png with its frame table in <dir>/atlas.txt.
+// Sheets keep their frame grid, so enemy clips in enemies.txt still address them.
+
+#include "../include/AnimationConfig.h"
+#include "../include/Map.h"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int PADDING = 2; // transparent pixels between blocks, so filtering never picks up a neighbour
+
+struct Recipe {
+    const char* name;
+    const char* file;
+    int frameWidth, frameHeight, frameCount; // 0 = the whole image is one frame
+    float scaleX, scaleY;                    // on-screen size / source size
+};
+
+struct Block {
+    const Recipe* recipe;
+    sf::Image pixels;
+    int frameWidth, frameHeight;
+    float drawScaleX, drawScaleY; // sprite scale that gives the original on-screen size
+    int x, y;
+};
+
+// Box filter over each destination pixel's footprint, alpha-weighted so
+// transparent pixels don't darken the edges
+void resample(const sf::Image& source, const sf::IntRect& from, sf::Image& target, const sf::IntRect& to) {
+    float stepX = static_cast<float>(from.width) / to.width;
+    float stepY = static_cast<float>(from.height) / to.height;
+    for (int dy = 0; dy < to.height; dy++) {
+        int y0 = from.top + static_cast<int>(dy * stepY);
+        int y1 = std::max(y0 + 1, from.top + static_cast<int>((dy + 1) * stepY));
+        for (int dx = 0; dx < to.width; dx++) {
+            int x0 = from.left + static_cast<int>(dx * stepX);
+            int x1 = std::max(x0 + 1, from.left + static_cast<int>((dx + 1) * stepX));
+
+            float r = 0.f, g = 0.f, b = 0.f, a = 0.f;
+            int count = 0;
+            for (int sy = y0; sy < y1; sy++) {
+                for (int sx = x0; sx < x1; sx++) {
+                    sf::Color c = source.getPixel(static_cast<unsigned int>(sx), static_cast<unsigned int>(sy));
+                    r += c.r * c.a;
+                    g += c.g * c.a;
+                    b += c.b * c.a;
+                    a += c.a;
+                    count++;
+                }
+            }
+            sf::Color result(0, 0, 0, 0);
+            if (a > 0.f) {
+                result = sf::Color(static_cast<sf::Uint8>(r / a + 0.5f), static_cast<sf::Uint8>(g / a + 0.5f),
+                                   static_cast<sf::Uint8>(b / a + 0.5f), static_cast<sf::Uint8>(a / count + 0.5f));
+            }
+            target.setPixel(static_cast<unsigned int>(to.left + dx), static_cast<unsigned int>(to.top + dy), result);
+        }
+    }
+}
+
+bool buildBlock(const std::string& directory, const Recipe& recipe, float factor, Block& block, std::size_t& sourceBytes) {
+    sf::Image source;
+    if (!source.loadFromFile(directory + "/" + recipe.file)) {
+        std::cerr << "Could not load " << recipe.file << std::endl;
+        return false;
+    }
+    sf::Vector2u size = source.getSize();
+    sourceBytes += static_cast<std::size_t>(size.x) * size.y * 4;
+
+    int frameWidth = recipe.frameCount > 0 ? recipe.frameWidth : static_cast<int>(size.x);
+    int frameHeight = recipe.frameCount > 0 ? recipe.frameHeight : static_cast<int>(size.y);
+    int columns = static_cast<int>(size.x) / frameWidth;
+    int rows = static_cast<int>(size.y) / frameHeight;
+    if (columns == 0 || rows == 0) {
+        std::cerr << recipe.file << " is smaller than one frame" << std::endl;
+        return false;
+    }
+
+    block.recipe = &recipe;
+    block.frameWidth = std::max(1, static_cast<int>(std::lround(frameWidth * recipe.scaleX * factor)));
+    block.frameHeight = std::max(1, static_cast<int>(std::lround(frameHeight * recipe.scaleY * factor)));
+    block.drawScaleX = recipe.scaleX * frameWidth / block.frameWidth;
+    block.drawScaleY = recipe.scaleY * frameHeight / block.frameHeight;
+
+    // Same grid, smaller frames
+    block.pixels.create(static_cast<unsigned int>(columns * block.frameWidth),
+                        static_cast<unsigned int>(rows * block.frameHeight), sf::Color::Transparent);
+    for (int row = 0; row < rows; row++) {
+        for (int column = 0; column < columns; column++) {
+            resample(source, sf::IntRect(column * frameWidth, row * frameHeight, frameWidth, frameHeight), block.pixels,
+                     sf::IntRect(column * block.frameWidth, row * block.frameHeight, block.frameWidth, block.frameHeight));
+        }
+    }
+    return true;
+}
+
+// Shelf packing, tallest first; returns the atlas height for 'width' (0 if a block doesn't fit)
+int pack(std::vector<Block*>& blocks, int width) {
+    int x = 0, y = 0, shelfHeight = 0;
+    for (Block* block : blocks) {
+        int w = static_cast<int>(block->pixels.getSize().x) + PADDING;
+        int h = static_cast<int>(block->pixels.getSize().y) + PADDING;
+        if (w > width) return 0;
+        if (x + w > width) {
+            x = 0;
+            y += shelfHeight;
+            shelfHeight = 0;
+        }
+        block->x = x;
+        block->y = y;
+        x += w;
+        shelfHeight = std::max(shelfHeight, h);
+    }
+    return y + shelfHeight;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: atlas_builder <assets dir> [--2x]" << std::endl;
+        return 1;
+    }
+    std::string directory = argv[1];
+    float factor = (argc > 2 && std::strcmp(argv[2], "--2x") == 0) ? 2.f : 1.f;
+
+    // Frame sizes and scales come from the game's own config
+    float tileScale = static_cast<float>(Map::getTileSize());
+    Recipe recipes[] = {
+        {"player", "Gun_player_spritesheet.png", PLAYER_SHEET.frameWidth, PLAYER_SHEET.frameHeight, PLAYER_SHEET.frameCount,
+         PLAYER_SHEET.scaleX, PLAYER_SHEET.scaleY},
+        {"enemy", "Enemy_spritesheet.png", ENEMY_SHEET.frameWidth, ENEMY_SHEET.frameHeight, ENEMY_SHEET.frameCount,
+         ENEMY_SHEET.scaleX, ENEMY_SHEET.scaleY},
+        {"wall", "wall.png", 0, 0, 0, 0.f, 0.f},
+        {"floor", "floor.png", 0, 0, 0, 0.f, 0.f},
+    };
+
+    std::vector<Block> blocks(sizeof(recipes) / sizeof(recipes[0]));
+    std::size_t sourceBytes = 0;
+    for (std::size_t i = 0; i < blocks.size(); i++) {
+        Recipe& recipe = recipes[i];
+        if (recipe.frameCount == 0) {
+            // Tiles: the whole image scaled to one tile
+            sf::Image probe;
+            if (!probe.loadFromFile(directory + "/" + recipe.file) || probe.getSize().x == 0 || probe.getSize().y == 0) {
+                std::cerr << "Could not load " << recipe.file << std::endl;
+                return 1;
+            }
+            recipe.scaleX = tileScale / probe.getSize().x;
+            recipe.scaleY = tileScale / probe.getSize().y;
+        }
+        if (!buildBlock(directory, recipe, factor, blocks[i], sourceBytes)) {
+            return 1;
+        }
+    }
+
+    std::vector<Block*> order;
+    for (Block& block : blocks) order.push_back(&block);
+    std::sort(order.begin(), order.end(),
+              [](const Block* a, const Block* b) { return a->pixels.getSize().y > b->pixels.getSize().y; });
+
+    // Smallest power-of-two square-ish atlas that holds everything
+    int width = 64, height = 0;
+    while ((height = pack(order, width)) == 0 || height > width) {
+        width *= 2;
+        if (width > 8192) {
+            std::cerr << "Atlas would exceed 8192 pixels" << std::endl;
+            return 1;
+        }
+    }
+
+    sf::Image atlas;
+    atlas.create(static_cast<unsigned int>(width), static_cast<unsigned int>(height), sf::Color::Transparent);
+    for (const Block& block : blocks) {
+        atlas.copy(block.pixels, static_cast<unsigned int>(block.x), static_cast<unsigned int>(block.y));
+    }
+
+    std::string imagePath = directory + "/atlas.png";
+    std::string tablePath = directory + "/atlas.txt";
+    if (!atlas.saveToFile(imagePath)) {
+        std::cerr << "Could not write " << imagePath << std::endl;
+        return 1;
+    }
+
+    std::ofstream table(tablePath, std::ios::trunc);
+    if (!table) {
+        std::cerr << "Could not write " << tablePath << std::endl;
+        return 1;
+    }
+    table << "# Generated by atlas_builder" << (factor > 1.f ? " --2x" : "") << " from AnimationConfig.h - do not edit\n";
+    table << "# <name> <x> <y> <width> <height> <frameWidth> <frameHeight> <frameCount> <scaleX> <scaleY>\n";
+    for (const Block& block : blocks) {
+        int frameCount = block.recipe->frameCount > 0 ? block.recipe->frameCount : 1;
+        table << block.recipe->name << ' ' << block.x << ' ' << block.y << ' ' << block.pixels.getSize().x << ' '
+              << block.pixels.getSize().y << ' ' << block.frameWidth << ' ' << block.frameHeight << ' ' << frameCount
+              << ' ' << block.drawScaleX << ' ' << block.drawScaleY << '\n';
+    }
+
+    std::cout << "Wrote " << imagePath << " (" << width << "x" << height << "): "
+              << static_cast<std::size_t>(width) * height * 4 / 1024 << " KB of texture instead of "
+              << sourceBytes / 1024 << " KB" << std::endl;
+    return 0;
+}